@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2017-07-24     Tanek        the first version
  * 2018-11-12     Ernest Chen  modify copyright
+ * 2026-10-19     tangmenglin  record entry latency of tick interrupt
  */
  
 #include <stdint.h>
@@ -99,8 +100,44 @@ void rt_hw_board_init()
 #endif
 }
 
+#ifdef RT_USING_LATENCY
+#define TICK_CYCLES (RT_CPU_CLOCK_HZ / RT_TICK_PER_SECOND)
+
+// The tick interrupt is raised every TICK_CYCLES cycles. The earliest entry
+// seen so far stands for the raise, so the recorded latency is the delay
+// beyond the fastest entry. A tick missed altogether does not shift it.
+static void tick_latency(void)
+{
+    static rt_uint32_t tick_raised;
+    static rt_bool_t tick_started = RT_FALSE;
+    rt_uint32_t now = rt_hw_cycle_get();
+
+    if (!tick_started)
+    {
+        tick_raised = now;
+        tick_started = RT_TRUE;
+    }
+
+    tick_raised += TICK_CYCLES;
+    if ((rt_int32_t)(now - tick_raised) < 0)
+    {
+        tick_raised = now; // earliest entry so far
+    }
+    while (now - tick_raised >= TICK_CYCLES)
+    {
+        tick_raised += TICK_CYCLES;
+    }
+
+    rt_latency_irq(tick_raised);
+}
+#endif
+
 void SysTick_Handler(void)
 {
+#ifdef RT_USING_LATENCY
+    tick_latency();
+#endif
+
     /* enter interrupt */
     // rt_interrupt_enter();
     pspDisableInterruptNumberMachineLevel(D_PSP_INTERRUPTS_MACHINE_TIMER);
@@ -16,6 +16,10 @@
 // <o>Maximal level of thread priority <8-256>
 //  <i>Default: 32
 #define RT_THREAD_PRIORITY_MAX 32
+// <c1>Find the highest ready priority by the CPU
+//  <i>__rt_ffs of the port uses ctz, one instruction with Zbb, instead of the lookup table
+// #define RT_USING_CPU_FFS
+// </c>
 // <o>OS tick per second
 //  <i>Default: 1000   (1ms)
 #define RT_TICK_PER_SECOND 1000
@@ -25,6 +29,13 @@
 // <o>the max length of object name<2-16>
 //  <i>Default: 8
 #define RT_NAME_MAX 8
+// <e>Index kernel objects by name
+//  <i>rt_object_find, rt_thread_find and rt_device_find look up a hash of names
+#define RT_USING_OBJECT_HASH
+// <o>the number of buckets for each object class, a power of 2 <2-256>
+//  <i>Default: 16
+#define RT_OBJECT_HASH_SIZE 16
+// </e>
 // <c1>Using RT-Thread components initialization
 //  <i>Using RT-Thread components initialization
 #define RT_USING_COMPONENTS_INIT
@@ -40,6 +51,45 @@
 //  <i>Default: 10
 #define RT_MAIN_THREAD_PRIORITY 10
 
+// <e>EDF scheduling band
+//  <i>Threads with deadlines and periods, ordered by absolute deadline within one priority level
+// #define RT_USING_SCHED_EDF
+// <o>the priority level of EDF band <0-31>
+//  <i>Default: 11
+#define RT_SCHED_EDF_PRIORITY 11
+// <o>the utilization admitted in EDF band, in percent <1-100>
+//  <i>Default: 100
+#define RT_SCHED_EDF_UTILIZATION 100
+// </e>
+// <c1>CPU budget of threads
+//  <i>A thread runs at most its budget of ticks in a period, then it is demoted or suspended
+// #define RT_USING_THREAD_BUDGET
+// </c>
+// <e>Time-triggered cyclic executive
+//  <i>Slots of a static schedule are released by tick at their offsets in a major frame
+// #define RT_USING_CYCLIC
+// <o>the ticks of major frame <1-65535>
+//  <i>Default: 10
+#define RT_CYCLIC_MAJOR_FRAME 10
+// </e>
+// <e>Periodic tasks in rate groups
+//  <i>Periodic callbacks of harmonic periods share the thread of one rate group
+// #define RT_USING_PERIODIC
+// <o>the maximal number of rate groups <1-8>
+//  <i>Default: 2
+#define RT_PERIODIC_GROUP_MAX 2
+// <o>the priority of the fastest rate group <0-31>
+//  <i>Default: 10
+#define RT_PERIODIC_PRIORITY 10
+// <o>the stack size of rate group threads
+//  <i>Default: 1024
+#define RT_PERIODIC_STACK_SIZE 1024
+// </e>
+// <c1>preemption threshold of threads
+//  <i>A running thread is only preempted by threads with a priority above its threshold
+#define RT_USING_PREEMPT_THRESHOLD
+// </c>
+
 // </h>
 
 // <h>Debug Configuration
@@ -50,10 +100,43 @@
 // <o>enable components initialization debug configuration<0-1>
 //  <i>Default: 0
 #define RT_DEBUG_INIT 0
+// <o>the most verbose rtdbg log level compiled in <0-3>
+//  <i>LOG_X less severe than this level are removed in all files, 0 error, 1 warning, 2 info, 3 debug
+//  <i>Default: 3
+#define RT_DBG_LEVEL_FLOOR 3
+// <c1>change rtdbg log level of modules at runtime
+//  <i>the levels are listed and set by dbglvl command
+// #define RT_USING_DBG_RUNTIME_LEVEL
+// </c>
+// <e>limit the rate of each rtdbg log call site
+//  <i>each LOG_X prints at most burst logs per interval
+// #define RT_USING_DBG_RATELIMIT
+// <o>logs per interval <1-65535>
+//  <i>Default: 10
+#define RT_DBG_RATELIMIT_BURST 10
+// <o>interval in ticks
+//  <i>Default: 1000
+#define RT_DBG_RATELIMIT_INTERVAL 1000
+// </e>
+// <c1>track anonymous objects
+//  <i>put the objects initialized without name in container, so list commands show them
+// #define RT_DEBUG_ANONYMOUS_OBJECT
+// </c>
 // <c1>thread stack over flow detect
 //  <i> Diable Thread stack over flow detect
 // #define RT_USING_OVERFLOW_CHECK
 // </c>
+// <c1>scheduler and interrupt latency histograms
+//  <i>log2 histograms of cycles from ready to run, in total and per thread, and of interrupt entry
+// #define RT_USING_LATENCY
+// </c>
+// <e>interrupts disabled and scheduler locked time profiler
+//  <i>cycles of the sections are accounted to the call sites disabling interrupt or locking scheduler
+// #define RT_USING_IRQOFF_PROFILE
+// <o>the maximal number of call sites of each kind <8-256>
+//  <i>Default: 32
+#define RT_IRQOFF_SITES 32
+// </e>
 // </h>
 
 // <h>Hook Configuration
@@ -65,6 +148,16 @@
 //  <i>using idle hook
 // #define RT_USING_IDLE_HOOK
 // </c>
+// <e>binary event trace (requires hook)
+//  <i>Record context switches, IPC, interrupts and timers into a ring buffer for tools/trace
+// #define RT_USING_TRACE
+// <o>Number of records in ring buffer <16-16384>
+//  <i>Default: 512
+#define RT_TRACE_BUF_SIZE 512
+// <o>Number of objects named in a dump <8-1024>
+//  <i>Default: 64
+#define RT_TRACE_OBJECTS 64
+// </e>
 // </h>
 
 // <e>Software timers Configuration
@@ -99,6 +192,19 @@
 //  <i>Using Message Queue
 #define RT_USING_MESSAGEQUEUE
 // </c>
+// <c1>Using array ring layout of Message Queue
+//  <i>Fixed size message slots without link header, suits tiny messages
+//  <i>The message is copied with interrupt disabled, so keep the messages small
+// #define RT_USING_MESSAGEQUEUE_RING
+// </c>
+// <e>Directed handoff wakeup of IPC
+//  <i>Releasing a semaphore or sending a message switches to the woken thread directly if it is the next one
+#define RT_USING_IPC_HANDOFF
+// <c1>donate the rest of timeslice to the woken thread
+//  <i>The woken thread runs on the timeslice left by the sender, if it is longer than its own
+// #define RT_IPC_HANDOFF_DONATE
+// </c>
+// </e>
 // </h>
 
 // <h>Memory Management Configuration
@@ -114,6 +220,42 @@
 //  <i>using tiny size of memory
 // #define RT_USING_TINY_SIZE
 // </c>
+// <c1>Arena allocator
+//  <i>Bump-pointer scratch buffers with bulk reset and checkpoints
+// #define RT_USING_ARENA
+// </c>
+// <e>Heap allocation trace recorder (requires hook)
+//  <i>Record malloc/free into a ring buffer for the host replay tool
+// #define RT_USING_MEMRECORD
+// <o>Number of records in ring buffer <16-4096>
+//  <i>Default: 256
+#define RT_MEMRECORD_BUF_SIZE 256
+// <o>Number of threads named in a dump <4-256>
+//  <i>Default: 32
+#define RT_MEMRECORD_THREADS 32
+// </e>
+// <e>Per-thread heap accounting (small memory only)
+//  <i>Track bytes, blocks, peak and allocation rate of each thread,
+//  <i>shown by the memstat and memtrace commands
+// #define RT_USING_MEMTRACE
+// <o>Maximum number of accounted threads <2-254>
+//  <i>Default: 16
+#define RT_MEMTRACE_SLOT_MAX 16
+// </e>
+// <e>Memory pressure notifications and reclaim callbacks
+//  <i>Invoke reclaim callbacks before heap allocation fails,
+//  <i>and post low/critical watermark events to subscribed mailboxes
+// #define RT_USING_MEMPRESSURE
+// <o>Low watermark, in percent of free heap <0-100>
+//  <i>Default: 25
+#define RT_MEM_PRESSURE_LOW_WATERMARK 25
+// <o>Critical watermark, in percent of free heap <0-100>
+//  <i>Default: 10
+#define RT_MEM_PRESSURE_CRITICAL_WATERMARK 10
+// <o>Reclaim passes of an allocation before it fails <1-255>
+//  <i>Default: 3
+#define RT_MEM_RECLAIM_RETRY 3
+// </e>
 // </h>
 
 // <h>Console Configuration
@@ -125,8 +267,33 @@
 //  <i>the buffer size of console
 //  <i>Default: 128  (128Byte)
 #define RT_CONSOLEBUF_SIZE 128
+// <e>Asynchronous rt_kprintf
+//  <i>Format into a ring of records and print them from a low priority thread.
+//  <i>The outputs beyond the ring are dropped, bulk dumps use rt_kprintf_sync
+// #define RT_USING_KPRINTF_ASYNC
+// <o>the number of records in ring, a power of 2 <2-256>
+//  <i>Default: 16
+#define RT_KPRINTF_ASYNC_RECORDS 16
+// <o>the priority of log thread <0-31>
+//  <i>Default: 30
+#define RT_KPRINTF_ASYNC_PRIORITY 30
+// <o>the stack size of log thread <256-4096>
+//  <i>Default: 512
+#define RT_KPRINTF_ASYNC_STACK_SIZE 512
+// </e>
+// <e>Tokenized logging
+//  <i>rt_ktoken_printf prints a token and raw arguments in base64,
+//  <i>decoded on host with the ELF file by tools/ktoken
+// #define RT_USING_KTOKEN
+// <o>the maximum size of a record <16-256>
+//  <i>Default: 48
+#define RT_KTOKEN_BUF_SIZE 48
+// </e>
 // </h>
 #define RT_USING_MEMPOOL
+// Lock-free memory pools (rt_mp_init_lockfree), allocated and freed in ISR.
+// They need the A extension, otherwise they are locked pools
+#define RT_USING_MEMPOOL_LOCKFREE
 #undef RT_USING_FINSH
 
 // Enable floating point printf for Kalman filter
@@ -29,6 +29,8 @@
  * 2018-11-22     Jesven       list_thread add smp support
  * 2018-12-27     Jesven       Fix the problem that disable interrupt too long in list_thread 
  *                             Provide protection for the "first layer of objects" when list_*
+ * 2026-10-19     tangmenglin  add list_edf
+ * 2026-10-19     tangmenglin  list_thread shows budget overruns
  */
 
 #include <rthw.h>
@@ -152,6 +154,14 @@ static rt_list_t *list_get_next(rt_list_t *current, list_get_next_t *arg)
     return node;
 }
 
+#ifdef RT_USING_THREAD_BUDGET
+#define LIST_THREAD_BUDGET_TITLE    " overrun"
+#define LIST_THREAD_BUDGET_SPLIT    " -------"
+#else
+#define LIST_THREAD_BUDGET_TITLE    ""
+#define LIST_THREAD_BUDGET_SPLIT    ""
+#endif
+
 long list_thread(void)
 {
     rt_ubase_t level;
@@ -166,11 +176,11 @@ long list_thread(void)
     maxlen = RT_NAME_MAX;
 
 #ifdef RT_USING_SMP
-    rt_kprintf("%-*.s cpu pri  status      sp     stack size max used left tick  error\n", maxlen, item_title); object_split(maxlen);
-    rt_kprintf(     " --- ---  ------- ---------- ----------  ------  ---------- ---\n");
+    rt_kprintf("%-*.s cpu pri  status      sp     stack size max used left tick  error" LIST_THREAD_BUDGET_TITLE "\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " --- ---  ------- ---------- ----------  ------  ---------- ---" LIST_THREAD_BUDGET_SPLIT "\n");
 #else
-    rt_kprintf("%-*.s pri  status      sp     stack size max used left tick  error\n", maxlen, item_title); object_split(maxlen);
-    rt_kprintf(     " ---  ------- ---------- ----------  ------  ---------- ---\n");
+    rt_kprintf("%-*.s pri  status      sp     stack size max used left tick  error" LIST_THREAD_BUDGET_TITLE "\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " ---  ------- ---------- ----------  ------  ---------- ---" LIST_THREAD_BUDGET_SPLIT "\n");
 #endif /*RT_USING_SMP*/
 
     do
@@ -220,7 +230,7 @@ long list_thread(void)
                     ptr = (rt_uint8_t *)thread->stack_addr + thread->stack_size - 1;
                     while (*ptr == '#')ptr --;
 
-                    rt_kprintf(" 0x%08x 0x%08x    %02d%%   0x%08x %03d\n",
+                    rt_kprintf(" 0x%08x 0x%08x    %02d%%   0x%08x %03d",
                             ((rt_ubase_t)thread->sp - (rt_ubase_t)thread->stack_addr),
                             thread->stack_size,
                             ((rt_ubase_t)ptr - (rt_ubase_t)thread->stack_addr) * 100 / thread->stack_size,
@@ -230,7 +240,7 @@ long list_thread(void)
                     ptr = (rt_uint8_t *)thread->stack_addr;
                     while (*ptr == '#')ptr ++;
 
-                    rt_kprintf(" 0x%08x 0x%08x    %02d%%   0x%08x %03d\n",
+                    rt_kprintf(" 0x%08x 0x%08x    %02d%%   0x%08x %03d",
                             thread->stack_size + ((rt_ubase_t)thread->stack_addr - (rt_ubase_t)thread->sp),
                             thread->stack_size,
                             (thread->stack_size - ((rt_ubase_t) ptr - (rt_ubase_t) thread->stack_addr)) * 100
@@ -238,6 +248,12 @@ long list_thread(void)
                             thread->remaining_tick,
                             thread->error);
 #endif
+#ifdef RT_USING_THREAD_BUDGET
+                    /* '*' for the thread out of budget */
+                    rt_kprintf(" %7d%c", thread->budget_overruns,
+                               thread->budget_throttled ? '*' : ' ');
+#endif
+                    rt_kprintf("\n");
                 }
             }
         }
@@ -249,6 +265,70 @@ long list_thread(void)
 FINSH_FUNCTION_EXPORT(list_thread, list thread);
 MSH_CMD_EXPORT(list_thread, list thread);
 
+#ifdef RT_USING_SCHED_EDF
+long list_edf(void)
+{
+    rt_ubase_t level;
+    list_get_next_t find_arg;
+    rt_list_t *obj_list[LIST_FIND_OBJ_NR];
+    rt_list_t *next = (rt_list_t*)RT_NULL;
+    const char *item_title = "thread";
+    rt_uint32_t utilization;
+    int maxlen;
+
+    list_find_init(&find_arg, RT_Object_Class_Thread, obj_list, sizeof(obj_list)/sizeof(obj_list[0]));
+
+    maxlen = RT_NAME_MAX;
+
+    rt_kprintf("%-*.s   period deadline  runtime deadline in missed\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " -------- -------- -------- ----------- ------\n");
+
+    do
+    {
+        next = list_get_next(next, &find_arg);
+        {
+            int i;
+            for (i = 0; i < find_arg.nr_out; i++)
+            {
+                struct rt_object *obj;
+                struct rt_thread thread_info;
+
+                obj = rt_list_entry(obj_list[i], struct rt_object, list);
+                level = rt_hw_interrupt_disable();
+
+                if ((obj->type & ~RT_Object_Class_Static) != find_arg.type)
+                {
+                    rt_hw_interrupt_enable(level);
+                    continue;
+                }
+                /* copy info */
+                memcpy(&thread_info, obj, sizeof thread_info);
+                rt_hw_interrupt_enable(level);
+
+                if (thread_info.edf_period == 0)
+                    continue;
+
+                rt_kprintf("%-*.*s %8d %8d %8d %11d %6d\n", maxlen, RT_NAME_MAX, thread_info.name,
+                           thread_info.edf_period,
+                           thread_info.edf_rel_deadline,
+                           thread_info.edf_runtime,
+                           (rt_int32_t)(thread_info.edf_deadline - rt_tick_get()),
+                           thread_info.edf_missed);
+            }
+        }
+    }
+    while (next != (rt_list_t*)RT_NULL);
+
+    utilization = rt_thread_edf_utilization();
+    rt_kprintf("utilization %d.%d%% of %d%%\n",
+               utilization / 10, utilization % 10, RT_SCHED_EDF_UTILIZATION);
+
+    return 0;
+}
+FINSH_FUNCTION_EXPORT(list_edf, list EDF threads);
+MSH_CMD_EXPORT(list_edf, list EDF threads);
+#endif
+
 static void show_wait_queue(struct rt_list_node *list)
 {
     struct rt_thread *thread;
@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2016-11-12     Bernard      The first version
  * 2018-05-25     armink       Add simple API, such as LOG_D, LOG_E
+ * 2026-10-19     tangmenglin  Add level floor, runtime levels and rate limit
  */
 
 /*
@@ -25,6 +26,17 @@
  * Then in your C/C++ file, you can use LOG_X macro to print out logs:
  * LOG_D("this is a debug log!");
  * LOG_E("this is a error log!");
+ *
+ * The LOG_X less severe than RT_DBG_LEVEL_FLOOR are removed in all files,
+ * whatever DBG_LVL says, and their arguments are never evaluated.
+ *
+ * With RT_USING_DBG_RUNTIME_LEVEL, the level of each DBG_TAG can be lowered
+ * at runtime by rt_dbg_level_set or the dbglvl command, and raised again up
+ * to the level compiled in.
+ *
+ * With RT_USING_DBG_RATELIMIT, each LOG_X call site prints at most
+ * RT_DBG_RATELIMIT_BURST logs per RT_DBG_RATELIMIT_INTERVAL ticks, and
+ * reports how many it dropped when it prints again.
  */
 
 #ifndef RT_DBG_H__
@@ -77,6 +89,36 @@
 #endif
 #endif /* DBG_LVL */
 
+/* the logs less severe than floor are removed in all files */
+#if defined(RT_DBG_LEVEL_FLOOR) && (DBG_LEVEL > RT_DBG_LEVEL_FLOOR)
+#undef DBG_LEVEL
+#define DBG_LEVEL         RT_DBG_LEVEL_FLOOR
+#endif
+
+#if defined(RT_USING_DBG_RUNTIME_LEVEL) || defined(RT_USING_DBG_RATELIMIT)
+#include <rtthread.h>
+#endif
+
+#ifdef RT_USING_DBG_RUNTIME_LEVEL
+/* the level of this file at runtime, set by rt_dbg_level_set */
+RT_USED static struct rt_dbg_module _dbg_module SECTION("rt_dbg_module") =
+{
+    DBG_SECTION_NAME, DBG_LEVEL, DBG_LEVEL
+};
+#define _DBG_ENABLED(n)      ((n) <= _dbg_module.level)
+#else
+#define _DBG_ENABLED(n)      1
+#endif
+
+#ifdef RT_USING_DBG_RATELIMIT
+/* the rate limit state, one for each call site */
+#define _DBG_RATELIMIT_STATE static struct rt_dbg_ratelimit _dbg_ratelimit
+#define _DBG_RATELIMIT_PASS  rt_dbg_ratelimit(&_dbg_ratelimit, DBG_SECTION_NAME)
+#else
+#define _DBG_RATELIMIT_STATE
+#define _DBG_RATELIMIT_PASS  1
+#endif
+
 /*
  * The color for terminal (foreground)
  * BLACK    30
@@ -108,7 +150,7 @@
  *       It will be DISCARDED later. Because it will take up more resources.
  */
 #define dbg_log(level, fmt, ...)                            \
-    if ((level) <= DBG_LEVEL)                               \
+    if ((level) <= DBG_LEVEL && _DBG_ENABLED(level))        \
     {                                                       \
         switch(level)                                       \
         {                                                   \
@@ -137,6 +179,16 @@
     }                                                       \
     while (0)
 
+/* the line of LOG_X, checked against runtime level and rate limit */
+#define _dbg_log_line(level, lvl, color_n, fmt, ...)        \
+    do                                                      \
+    {                                                       \
+        _DBG_RATELIMIT_STATE;                               \
+        if (_DBG_ENABLED(level) && _DBG_RATELIMIT_PASS)     \
+            dbg_log_line(lvl, color_n, fmt, ##__VA_ARGS__); \
+    }                                                       \
+    while (0)
+
 #define dbg_raw(...)         rt_kprintf(__VA_ARGS__);
 
 #else
@@ -145,29 +197,30 @@
 #define dbg_enter
 #define dbg_exit
 #define dbg_log_line(lvl, color_n, fmt, ...)
+#define _dbg_log_line(level, lvl, color_n, fmt, ...)
 #define dbg_raw(...)
 #endif /* DBG_ENABLE */
 
 #if (DBG_LEVEL >= DBG_LOG)
-#define LOG_D(fmt, ...)      dbg_log_line("D", 0, fmt, ##__VA_ARGS__)
+#define LOG_D(fmt, ...)      _dbg_log_line(DBG_LOG, "D", 0, fmt, ##__VA_ARGS__)
 #else
 #define LOG_D(...)
 #endif
 
 #if (DBG_LEVEL >= DBG_INFO)
-#define LOG_I(fmt, ...)      dbg_log_line("I", 32, fmt, ##__VA_ARGS__)
+#define LOG_I(fmt, ...)      _dbg_log_line(DBG_INFO, "I", 32, fmt, ##__VA_ARGS__)
 #else
 #define LOG_I(...)
 #endif
 
 #if (DBG_LEVEL >= DBG_WARNING)
-#define LOG_W(fmt, ...)      dbg_log_line("W", 33, fmt, ##__VA_ARGS__)
+#define LOG_W(fmt, ...)      _dbg_log_line(DBG_WARNING, "W", 33, fmt, ##__VA_ARGS__)
 #else
 #define LOG_W(...)
 #endif
 
 #if (DBG_LEVEL >= DBG_ERROR)
-#define LOG_E(fmt, ...)      dbg_log_line("E", 31, fmt, ##__VA_ARGS__)
+#define LOG_E(fmt, ...)      _dbg_log_line(DBG_ERROR, "E", 31, fmt, ##__VA_ARGS__)
 #else
 #define LOG_E(...)
 #endif
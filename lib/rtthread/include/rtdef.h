@@ -215,6 +215,8 @@ typedef int (*init_fn_t)(void);
 #define INIT_ENV_EXPORT(fn)             INIT_EXPORT(fn, "5")
 /* appliation initialization (rtgui application etc ...) */
 #define INIT_APP_EXPORT(fn)             INIT_EXPORT(fn, "6")
+/* statically defined kernel objects, right after board initialization */
+#define INIT_OBJECT_EXPORT(fn)          INIT_EXPORT(fn, "1.obj")
 
 #if !defined(RT_USING_FINSH)
 /* define these to empty, even if not include finsh.h file */
@@ -339,6 +341,9 @@ struct rt_object
     void      *module_id;                               /**< id of application module */
 #endif
     rt_list_t  list;                                    /**< list node of kernel object */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object *hash_next;                        /**< next object in the same name bucket */
+#endif
 };
 typedef struct rt_object *rt_object_t;                  /**< Type for kernel objects. */
 
@@ -377,6 +382,11 @@ enum rt_object_class_type
     RT_Object_Class_Static = 0x80                       /**< The object is a static object. */
 };
 
+/* the number of name buckets for each object class, a power of 2 */
+#ifndef RT_OBJECT_HASH_SIZE
+#define RT_OBJECT_HASH_SIZE             16
+#endif
+
 /**
  * The information of the kernel object
  */
@@ -385,6 +395,9 @@ struct rt_object_information
     enum rt_object_class_type type;                     /**< object class type */
     rt_list_t                 object_list;              /**< object list */
     rt_size_t                 object_size;              /**< object size */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object         *hash[RT_OBJECT_HASH_SIZE];/**< objects by hash of name */
+#endif
 };
 
 /**
@@ -397,6 +410,30 @@ struct rt_object_information
 #define RT_OBJECT_HOOK_CALL(func, argv)
 #endif
 
+#ifdef RT_USING_TRACE
+/**
+ * trace events, in the low bits of record timestamp
+ */
+#define RT_TRACE_SWITCH                 0x00            /**< switch to thread */
+#define RT_TRACE_TRYTAKE                0x01            /**< try to take IPC object */
+#define RT_TRACE_TAKE                   0x02            /**< IPC object taken */
+#define RT_TRACE_PUT                    0x03            /**< IPC object released */
+#define RT_TRACE_IRQ_ENTER              0x04            /**< enter interrupt */
+#define RT_TRACE_IRQ_LEAVE              0x05            /**< leave interrupt */
+#define RT_TRACE_TIMER_ENTER            0x06            /**< timer timeout function starts */
+#define RT_TRACE_TIMER_EXIT             0x07            /**< timer timeout function returns */
+#define RT_TRACE_EVENT_MASK             0x07            /**< mask of event in timestamp */
+
+/**
+ * event trace record
+ */
+struct rt_trace_record
+{
+    rt_uint32_t timestamp;                              /**< cycle count, the low bits are the event */
+    rt_uint32_t object;                                 /**< object of event, nest of interrupt */
+};
+#endif
+
 /**@}*/
 
 /**
@@ -496,6 +533,66 @@ typedef siginfo_t rt_siginfo_t;
 #define RT_THREAD_CTRL_CLOSE            0x01                /**< Close thread. */
 #define RT_THREAD_CTRL_CHANGE_PRIORITY  0x02                /**< Change thread priority. */
 #define RT_THREAD_CTRL_INFO             0x03                /**< Get thread information. */
+#define RT_THREAD_CTRL_SET_EDF          0x04                /**< Set EDF parameters of thread. */
+#define RT_THREAD_CTRL_SET_BUDGET       0x05                /**< Set CPU budget of thread. */
+#define RT_THREAD_CTRL_SET_THRESHOLD    0x06                /**< Set preemption threshold of thread. */
+
+#define RT_THREAD_BUDGET_DEMOTE         0x00                /**< Demote thread out of budget. */
+#define RT_THREAD_BUDGET_SUSPEND        0x01                /**< Suspend thread out of budget. */
+
+#ifdef RT_USING_SCHED_EDF
+/**
+ * EDF parameters of thread, see RT_THREAD_CTRL_SET_EDF
+ */
+struct rt_thread_edf
+{
+    rt_tick_t runtime;                                  /**< worst case execution time of a job */
+    rt_tick_t deadline;                                 /**< relative deadline, 0 for the period */
+    rt_tick_t period;                                   /**< period of jobs, 0 to leave EDF band */
+};
+#endif
+
+#ifdef RT_USING_THREAD_BUDGET
+/**
+ * CPU budget of thread, see RT_THREAD_CTRL_SET_BUDGET
+ */
+struct rt_thread_budget
+{
+    rt_tick_t  budget;                                  /**< ticks allowed in a period, 0 for no limit */
+    rt_tick_t  period;                                  /**< replenishment period */
+    rt_uint8_t policy;                                  /**< RT_THREAD_BUDGET_DEMOTE or RT_THREAD_BUDGET_SUSPEND */
+    rt_uint8_t priority;                                /**< priority of demoted thread */
+};
+#endif
+
+#ifdef RT_USING_LATENCY
+#define RT_LATENCY_BUCKETS              16              /**< log2 buckets of latency histogram */
+
+/**
+ * latency histogram in cycles, bucket i counts samples from 2^i to 2^(i+1) - 1
+ */
+struct rt_latency_hist
+{
+    rt_uint32_t count[RT_LATENCY_BUCKETS];              /**< samples of each bucket, the last one unbounded */
+    rt_uint32_t max;                                    /**< maximal sample */
+};
+#endif
+
+#ifdef RT_USING_IRQOFF_PROFILE
+#define RT_IRQOFF_IRQ                   0x00            /**< sections with interrupt disabled */
+#define RT_IRQOFF_LOCK                  0x01            /**< sections with scheduler locked */
+
+/**
+ * call site which disables interrupt or locks scheduler, see rt_irqoff_get
+ */
+struct rt_irqoff_site
+{
+    rt_ubase_t  caller;                                 /**< return address of the call */
+    rt_uint32_t count;                                  /**< number of sections */
+    rt_uint32_t max;                                    /**< maximal cycles of a section */
+    rt_uint64_t total;                                  /**< total cycles of sections */
+};
+#endif
 
 /**
  * Thread structure
@@ -529,9 +626,12 @@ struct rt_thread
     /* priority */
     rt_uint8_t  current_priority;                       /**< current priority */
     rt_uint8_t  init_priority;                          /**< initialized priority */
+#ifdef RT_USING_PREEMPT_THRESHOLD
+    rt_uint8_t  preempt_threshold;                      /**< only priority above it preempts the thread */
+#endif
 #if RT_THREAD_PRIORITY_MAX > 32
     rt_uint8_t  number;
-    rt_uint8_t  high_mask;
+    rt_uint32_t high_mask;
 #endif
     rt_uint32_t number_mask;
 
@@ -553,6 +653,29 @@ struct rt_thread
     rt_ubase_t  init_tick;                              /**< thread's initialized tick */
     rt_ubase_t  remaining_tick;                         /**< remaining tick */
 
+#ifdef RT_USING_SCHED_EDF
+    rt_tick_t   edf_runtime;                            /**< worst case execution time of a job */
+    rt_tick_t   edf_rel_deadline;                       /**< relative deadline of a job */
+    rt_tick_t   edf_period;                             /**< period of jobs, 0 out of EDF band */
+    rt_tick_t   edf_release;                            /**< release time of current job */
+    rt_tick_t   edf_deadline;                           /**< absolute deadline of current job */
+    rt_uint32_t edf_missed;                             /**< number of missed deadlines */
+    rt_uint8_t  edf_saved_priority;                     /**< priority before entering EDF band */
+#endif
+
+#ifdef RT_USING_THREAD_BUDGET
+    rt_tick_t   budget;                                 /**< ticks allowed in a period, 0 for no limit */
+    rt_tick_t   budget_period;                          /**< replenishment period */
+    rt_tick_t   budget_remaining;                       /**< ticks left in current period */
+    rt_tick_t   budget_start;                           /**< start of current period */
+    rt_uint8_t  budget_policy;                          /**< what to do out of budget */
+    rt_uint8_t  budget_priority;                        /**< priority of demoted thread */
+    rt_uint8_t  budget_saved_priority;                  /**< priority before demoted */
+    rt_uint8_t  budget_throttled;                       /**< out of budget until replenished */
+    rt_uint32_t budget_overruns;                        /**< number of times out of budget */
+    struct rt_timer budget_timer;                       /**< replenishment timer */
+#endif
+
     struct rt_timer thread_timer;                       /**< built-in thread timer */
 
     void (*cleanup)(struct rt_thread *tid);             /**< cleanup function when thread exit */
@@ -562,10 +685,66 @@ struct rt_thread
     void        *lwp;
 #endif
 
+#ifdef RT_USING_MEMTRACE
+    rt_uint8_t  mem_slot;                               /**< heap accounting slot of thread */
+#endif
+
+#ifdef RT_USING_LATENCY
+    rt_uint32_t ready_cycle;                            /**< cycle count when the thread became ready */
+    struct rt_latency_hist latency;                     /**< wakeup-to-run latency */
+#endif
+
     rt_uint32_t user_data;                             /**< private user data beyond this thread */
 };
 typedef struct rt_thread *rt_thread_t;
 
+#ifdef RT_USING_CYCLIC
+/**
+ * slot of time-triggered schedule, see RT_CYCLIC_SLOT
+ */
+struct rt_cyclic_slot
+{
+    const char *name;                                   /**< name of slot */
+    rt_tick_t   offset;                                 /**< release tick in major frame */
+    rt_tick_t   budget;                                 /**< ticks allowed to the job of thread, 0 for no limit */
+    void      (*entry)(void);                           /**< function called by tick, or RT_NULL */
+    struct rt_thread *thread;                           /**< thread resumed by tick, or RT_NULL */
+
+    rt_uint32_t release;                                /**< cycle count of last release */
+    rt_uint32_t latency_min;                            /**< minimal cycles from release to start */
+    rt_uint32_t latency_max;                            /**< maximal cycles from release to start */
+    rt_uint32_t runs;                                   /**< number of jobs started */
+    rt_uint32_t overruns;                               /**< number of jobs out of budget */
+    rt_uint32_t skips;                                  /**< releases skipped for unfinished job */
+    rt_uint8_t  running;                                /**< the job of thread is running */
+    rt_uint8_t  throttled;                              /**< the job is suspended out of budget */
+};
+#endif
+
+#ifdef RT_USING_PERIODIC
+/**
+ * periodic task run by the thread of its rate group, see RT_PERIODIC_TASK_DEFINE
+ */
+struct rt_periodic_task
+{
+    const char *name;                                   /**< name of task */
+    rt_tick_t   period;                                 /**< ticks between two releases */
+    rt_tick_t   offset;                                 /**< ticks from boot to the first release */
+    void      (*callback)(void *parameter);             /**< function called at each release */
+    void       *parameter;                              /**< parameter of callback */
+
+    struct rt_periodic_task *next;                      /**< next task in the rate group */
+    rt_tick_t   release;                                /**< tick of next release */
+    rt_uint32_t last_start;                             /**< cycle count of last start */
+    rt_uint32_t exec_min;                               /**< minimal cycles of a call */
+    rt_uint32_t exec_max;                               /**< maximal cycles of a call */
+    rt_uint32_t interval_min;                           /**< minimal cycles between two starts */
+    rt_uint32_t interval_max;                           /**< maximal cycles between two starts */
+    rt_uint32_t runs;                                   /**< number of calls */
+    rt_uint32_t overruns;                               /**< calls returned after the next release */
+};
+#endif
+
 /**@}*/
 
 /**
@@ -684,11 +863,25 @@ struct rt_messagequeue
 
     rt_uint16_t          entry;                         /**< index of messages in the queue */
 
+#ifdef RT_USING_MESSAGEQUEUE_RING
+    rt_uint16_t          in_offset;                     /**< input offset of the message ring */
+    rt_uint16_t          out_offset;                    /**< output offset of the message ring */
+#else
     void                *msg_queue_head;                /**< list head */
     void                *msg_queue_tail;                /**< list tail */
     void                *msg_queue_free;                /**< pointer indicated the free node of queue */
+#endif
 };
 typedef struct rt_messagequeue *rt_mq_t;
+
+/* the pool size of a message queue holding max_msgs messages */
+#ifdef RT_USING_MESSAGEQUEUE_RING
+#define RT_MQ_POOL_SIZE(msg_size, max_msgs)                                 \
+    ((msg_size) * (max_msgs))
+#else
+#define RT_MQ_POOL_SIZE(msg_size, max_msgs)                                 \
+    ((RT_ALIGN(msg_size, RT_ALIGN_SIZE) + sizeof(void *)) * (max_msgs))
+#endif
 #endif
 
 /**@}*/
@@ -742,7 +935,76 @@ struct rt_memheap
 };
 #endif
 
+#ifdef RT_USING_ARENA
+/**
+ * arena allocator
+ */
+struct rt_arena
+{
+    rt_uint8_t *start_addr;                             /**< start address of arena */
+    rt_uint8_t *ptr;                                    /**< next free byte */
+    rt_uint8_t *end;                                    /**< end address of arena */
+
+    rt_size_t   max_used;                               /**< maximum allocated size */
+};
+typedef struct rt_arena *rt_arena_t;
+typedef rt_uint8_t *rt_arena_mark_t;                    /**< checkpoint of arena */
+#endif
+
+#ifdef RT_USING_MEMRECORD
+/**
+ * heap allocation trace record
+ */
+struct rt_memrecord_item
+{
+    rt_uint32_t timestamp;                              /**< time of operation */
+    rt_uint32_t thread;                                 /**< thread, 0 without thread context */
+    rt_uint32_t ptr;                                    /**< address of memory block */
+    rt_uint32_t size;                                   /**< allocated size, 0 for release */
+};
+#endif
+
+#ifdef RT_USING_MEMTRACE
+#define RT_MEMTRACE_SLOT_NONE           0xff            /**< thread has no heap accounting slot */
+
+/**
+ * heap usage of a thread
+ */
+struct rt_mem_thread_stat
+{
+    char        name[RT_NAME_MAX];                      /**< name of thread */
+    rt_thread_t thread;                                 /**< owner thread, RT_NULL when exited */
+
+    rt_size_t   used;                                   /**< bytes in use, including block header */
+    rt_size_t   blocks;                                 /**< blocks in use */
+    rt_size_t   max_used;                               /**< peak bytes in use */
+
+    rt_uint32_t rate;                                   /**< allocations per second */
+    rt_uint32_t count;                                  /**< allocations in current window */
+    rt_tick_t   tick;                                   /**< start tick of current window */
+};
+#endif
+
+#ifdef RT_USING_MEMPRESSURE
+/* the reclaim passes of an allocation before it fails */
+#ifndef RT_MEM_RECLAIM_RETRY
+#define RT_MEM_RECLAIM_RETRY                3
+#endif
+
+/**
+ * memory pressure level of system heap
+ */
+enum rt_mem_pressure_level
+{
+    RT_MEM_PRESSURE_NORMAL = 0,                         /**< free memory above low watermark */
+    RT_MEM_PRESSURE_LOW,                                /**< free memory below low watermark */
+    RT_MEM_PRESSURE_CRITICAL,                           /**< free memory below critical watermark */
+};
+#endif
+
 #ifdef RT_USING_MEMPOOL
+#define RT_MP_FLAG_LOCKFREE             0x01            /**< lock-free memory pool, usable in interrupt */
+
 /**
  * Base structure of Memory pool object
  */
@@ -761,12 +1023,52 @@ struct rt_mempool
 
     rt_list_t        suspend_thread;                    /**< threads pended on this resource */
     rt_size_t        suspend_thread_count;              /**< numbers of thread pended on this resource */
+
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+    rt_ubase_t       block_head;                        /**< lock-free block list, tag and block index */
+#endif
 };
 typedef struct rt_mempool *rt_mp_t;
 #endif
 
 /**@}*/
 
+#ifdef RT_USING_KTOKEN
+/**
+ * tokenized log format, kept in rt_ktoken section. The token of a format is
+ * its offset in the section divided by 4.
+ */
+struct rt_ktoken
+{
+    rt_uint32_t types;                                  /**< number and types of arguments */
+    char        fmt[];                                  /**< format string */
+};
+#endif
+
+#ifdef RT_USING_DBG_RUNTIME_LEVEL
+/**
+ * log level of a rtdbg module at runtime, kept in rt_dbg_module section
+ */
+struct rt_dbg_module
+{
+    const char *tag;                                    /**< DBG_TAG of module */
+    rt_uint8_t  level;                                  /**< current level */
+    rt_uint8_t  compiled;                               /**< the most verbose level compiled in */
+};
+#endif
+
+#ifdef RT_USING_DBG_RATELIMIT
+/**
+ * rate limit state of a rtdbg call site
+ */
+struct rt_dbg_ratelimit
+{
+    rt_tick_t   begin;                                  /**< start of current interval */
+    rt_uint16_t count;                                  /**< logs printed in the interval */
+    rt_uint16_t suppressed;                             /**< logs suppressed in the interval */
+};
+#endif
+
 #ifdef RT_USING_DEVICE
 /**
  * @addtogroup Device
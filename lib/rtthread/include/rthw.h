@@ -117,6 +117,11 @@ void rt_hw_exception_install(rt_err_t (*exception_handle)(void *context));
  */
 void rt_hw_us_delay(rt_uint32_t us);
 
+/*
+ * cycle counter interfaces
+ */
+rt_uint32_t rt_hw_cycle_get(void);
+
 #define RT_DEFINE_SPINLOCK(x)  
 #define RT_DECLARE_SPINLOCK(x)    rt_ubase_t x
 
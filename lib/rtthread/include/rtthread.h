@@ -138,6 +138,39 @@ rt_err_t rt_thread_delete(rt_thread_t thread);
 rt_err_t rt_thread_yield(void);
 rt_err_t rt_thread_delay(rt_tick_t tick);
 rt_err_t rt_thread_mdelay(rt_int32_t ms);
+#ifdef RT_USING_SCHED_EDF
+rt_err_t rt_thread_edf_wait(void);
+rt_uint32_t rt_thread_edf_utilization(void);
+#endif
+#ifdef RT_USING_THREAD_BUDGET
+void rt_thread_budget_charge(rt_thread_t thread);
+#endif
+#ifdef RT_USING_CYCLIC
+void rt_cyclic_start(void);
+void rt_cyclic_stop(void);
+void rt_cyclic_tick(void);
+struct rt_cyclic_slot *rt_cyclic_wait(void);
+#endif
+#ifdef RT_USING_PERIODIC
+int rt_periodic_init(void);
+#endif
+#ifdef RT_USING_LATENCY
+void rt_latency_ready(struct rt_thread *thread);
+void rt_latency_switch(struct rt_thread *from, struct rt_thread *to);
+void rt_latency_irq(rt_uint32_t raised);
+void rt_latency_wakeup_get(rt_thread_t thread, struct rt_latency_hist *hist);
+void rt_latency_irq_get(struct rt_latency_hist *hist);
+void rt_latency_reset(void);
+#endif
+#ifdef RT_USING_IRQOFF_PROFILE
+rt_base_t rt_irqoff_enter(rt_base_t level, rt_ubase_t caller);
+void rt_irqoff_leave(void);
+void rt_irqoff_lock_enter(rt_ubase_t caller);
+void rt_irqoff_lock_leave(void);
+int rt_irqoff_get(int type, struct rt_irqoff_site *sites, int nr);
+rt_uint32_t rt_irqoff_dropped(int type);
+void rt_irqoff_reset(void);
+#endif
 rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg);
 rt_err_t rt_thread_suspend(rt_thread_t thread);
 rt_err_t rt_thread_resume(rt_thread_t thread);
@@ -175,6 +208,9 @@ void rt_system_scheduler_start(void);
 void rt_schedule(void);
 void rt_schedule_insert_thread(struct rt_thread *thread);
 void rt_schedule_remove_thread(struct rt_thread *thread);
+#ifdef RT_USING_IPC_HANDOFF
+void rt_schedule_handoff(struct rt_thread *thread, rt_base_t level);
+#endif
 
 void rt_enter_critical(void);
 void rt_exit_critical(void);
@@ -219,6 +255,13 @@ rt_err_t rt_mp_init(struct rt_mempool *mp,
                     rt_size_t          size,
                     rt_size_t          block_size);
 rt_err_t rt_mp_detach(struct rt_mempool *mp);
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+rt_err_t rt_mp_init_lockfree(struct rt_mempool *mp,
+                             const char        *name,
+                             void              *start,
+                             rt_size_t          size,
+                             rt_size_t          block_size);
+#endif
 rt_mp_t rt_mp_create(const char *name,
                      rt_size_t   block_count,
                      rt_size_t   block_size);
@@ -254,6 +297,9 @@ void rt_memory_info(rt_uint32_t *total,
 #ifdef RT_USING_SLAB
 void *rt_page_alloc(rt_size_t npages);
 void rt_page_free(void *addr, rt_size_t npages);
+void rt_page_info(rt_uint32_t *total,
+                  rt_uint32_t *free,
+                  rt_uint32_t *max_free);
 #endif
 
 #ifdef RT_USING_HOOK
@@ -261,6 +307,35 @@ void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
 void rt_free_sethook(void (*hook)(void *ptr));
 #endif
 
+#ifdef RT_USING_MEMRECORD
+void rt_memrecord_start(void);
+void rt_memrecord_stop(void);
+void rt_memrecord_clear(void);
+rt_size_t rt_memrecord_read(struct rt_memrecord_item *buffer, rt_size_t count);
+rt_uint32_t rt_memrecord_dropped(void);
+#endif
+
+#ifdef RT_USING_MEMTRACE
+rt_err_t rt_memtrace_thread_get(rt_thread_t thread, struct rt_mem_thread_stat *stat);
+rt_size_t rt_memtrace_thread_list(struct rt_mem_thread_stat *stat, rt_size_t max);
+#endif
+
+#ifdef RT_USING_MEMPRESSURE
+void rt_mem_reclaim_init(void);
+rt_err_t rt_mem_reclaim_register(rt_size_t (*reclaim)(rt_size_t size, void *parameter),
+                                 void *parameter);
+rt_err_t rt_mem_reclaim_unregister(rt_size_t (*reclaim)(rt_size_t size, void *parameter));
+rt_size_t rt_mem_reclaim(rt_size_t size);
+
+#ifdef RT_USING_MAILBOX
+rt_err_t rt_mem_pressure_subscribe(rt_mailbox_t mb);
+rt_err_t rt_mem_pressure_unsubscribe(rt_mailbox_t mb);
+#endif
+rt_err_t rt_mem_pressure_set_watermark(rt_uint8_t low, rt_uint8_t critical);
+rt_uint8_t rt_mem_pressure_get_level(void);
+void rt_mem_pressure_check(rt_size_t total, rt_size_t used);
+#endif
+
 #endif
 
 #ifdef RT_USING_MEMHEAP
@@ -277,6 +352,25 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize);
 void rt_memheap_free(void *ptr);
 #endif
 
+#ifdef RT_USING_ARENA
+/**
+ * arena allocator interface
+ */
+rt_err_t rt_arena_init(struct rt_arena *arena, void *start, rt_size_t size);
+#ifdef RT_USING_HEAP
+rt_arena_t rt_arena_create(rt_size_t size);
+void rt_arena_delete(rt_arena_t arena);
+#endif
+void *rt_arena_alloc(rt_arena_t arena, rt_size_t size);
+void rt_arena_reset(rt_arena_t arena);
+rt_arena_mark_t rt_arena_save(rt_arena_t arena);
+void rt_arena_restore(rt_arena_t arena, rt_arena_mark_t mark);
+void rt_arena_info(rt_arena_t arena,
+                   rt_uint32_t *total,
+                   rt_uint32_t *used,
+                   rt_uint32_t *max_used);
+#endif
+
 /**@}*/
 
 /**
@@ -449,9 +543,95 @@ void rt_interrupt_enter_sethook(void (*hook)(void));
 void rt_interrupt_leave_sethook(void (*hook)(void));
 #endif
 
+#ifdef RT_USING_TRACE
+/*
+ * event trace interface
+ */
+void rt_trace_start(void);
+void rt_trace_stop(void);
+void rt_trace_clear(void);
+rt_size_t rt_trace_snapshot(struct rt_trace_record *buffer, rt_size_t count);
+rt_uint32_t rt_trace_lost(void);
+#endif
+
 #ifdef RT_USING_COMPONENTS_INIT
 void rt_components_init(void);
 void rt_components_board_init(void);
+
+#ifndef _MSC_VER
+/*
+ * static kernel object definition
+ *
+ * The control block and its stack or buffer are placed in the .bss.rt_object
+ * section, and the object is initialized by rt_components_init(): semaphores
+ * and message queues at INIT_OBJECT_EXPORT level, threads are initialized
+ * and started at INIT_APP_EXPORT level. No memory is taken from heap.
+ */
+#define RT_THREAD_DEFINE(thread, name, entry, parameter, stack_size, priority, tick) \
+    struct rt_thread thread SECTION(".bss.rt_object");                              \
+    ALIGN(RT_ALIGN_SIZE)                                                            \
+    static rt_uint8_t __rt_stack_##thread[stack_size] SECTION(".bss.rt_object");   \
+    static int __rt_thread_define_##thread(void)                                    \
+    {                                                                               \
+        rt_thread_init(&thread, name, entry, parameter,                             \
+                       __rt_stack_##thread, sizeof(__rt_stack_##thread),            \
+                       priority, tick);                                             \
+        return rt_thread_startup(&thread);                                          \
+    }                                                                               \
+    INIT_APP_EXPORT(__rt_thread_define_##thread)
+
+#ifdef RT_USING_SEMAPHORE
+#define RT_SEM_DEFINE(sem, name, value, flag)                                       \
+    struct rt_semaphore sem SECTION(".bss.rt_object");                              \
+    static int __rt_sem_define_##sem(void)                                          \
+    {                                                                               \
+        return rt_sem_init(&sem, name, value, flag);                                \
+    }                                                                               \
+    INIT_OBJECT_EXPORT(__rt_sem_define_##sem)
+#endif
+
+#ifdef RT_USING_MESSAGEQUEUE
+#define RT_MQ_DEFINE(mq, name, msg_size, max_msgs, flag)                            \
+    struct rt_messagequeue mq SECTION(".bss.rt_object");                            \
+    ALIGN(RT_ALIGN_SIZE)                                                            \
+    static rt_uint8_t __rt_mq_pool_##mq[RT_MQ_POOL_SIZE(msg_size, max_msgs)]       \
+        SECTION(".bss.rt_object");                                                  \
+    static int __rt_mq_define_##mq(void)                                            \
+    {                                                                               \
+        return rt_mq_init(&mq, name, __rt_mq_pool_##mq, msg_size,                   \
+                          sizeof(__rt_mq_pool_##mq), flag);                         \
+    }                                                                               \
+    INIT_OBJECT_EXPORT(__rt_mq_define_##mq)
+#endif
+#endif /* _MSC_VER */
+#endif /* RT_USING_COMPONENTS_INIT */
+
+#ifdef RT_USING_CYCLIC
+/*
+ * slot of time-triggered schedule
+ *
+ * The slots of all files, placed in the rt_cyclic_slot section, make up the
+ * schedule of major frame. At offset ticks into each frame, the tick calls
+ * the entry function, or releases the thread waiting in rt_cyclic_wait().
+ * The thread is suspended if its job runs budget ticks, below the frame.
+ */
+#define RT_CYCLIC_SLOT(slot, offset, budget, entry, thread)                         \
+    RT_USED struct rt_cyclic_slot slot SECTION("rt_cyclic_slot") =                  \
+    {#slot, offset, budget, entry, thread}
+#endif
+
+#ifdef RT_USING_PERIODIC
+/*
+ * periodic task, period and offset in milliseconds
+ *
+ * The tasks of all files, placed in the rt_periodic_task section, are merged
+ * into rate groups of harmonic periods at boot. The thread of each group calls
+ * the callback of task at each release.
+ */
+#define RT_PERIODIC_TASK_DEFINE(task, period, offset, callback, parameter)          \
+    RT_USED struct rt_periodic_task task SECTION("rt_periodic_task") =              \
+    {#task, (period) * RT_TICK_PER_SECOND / 1000,                                   \
+     (offset) * RT_TICK_PER_SECOND / 1000, callback, parameter}
 #endif
 
 /**
@@ -466,9 +646,91 @@ void rt_components_board_init(void);
 #ifndef RT_USING_CONSOLE
 #define rt_kprintf(...)
 #define rt_kputs(str)
+#define rt_kprintf_sync(sync)
 #else
 void rt_kprintf(const char *fmt, ...);
 void rt_kputs(const char *str);
+#ifdef RT_USING_KPRINTF_ASYNC
+void rt_kprintf_flush(void);
+void rt_kprintf_sync(rt_bool_t sync);
+rt_uint32_t rt_kprintf_dropped(void);
+#else
+#define rt_kprintf_sync(sync)
+#endif
+#endif
+
+#ifdef RT_USING_KTOKEN
+/*
+ * tokenized logging, rt_ktoken_printf(fmt, ...) takes the same arguments as
+ * rt_kprintf with a string literal format, and prints a record to be
+ * decoded by tools/ktoken. The arguments are described at compile time by
+ * RT_KTOKEN_TYPES, the number of arguments (up to 9) in the low 4 bits and
+ * 3 bits of type for each one.
+ */
+#define RT_KTOKEN_INT                   0   /**< int, long and pointer */
+#define RT_KTOKEN_INT64                 1   /**< long long */
+#define RT_KTOKEN_FLOAT                 2   /**< float */
+#define RT_KTOKEN_DOUBLE                3   /**< double */
+#define RT_KTOKEN_STRING                4   /**< string */
+#define RT_KTOKEN_COUNT_MASK            0x0f
+
+#define __RT_KTOKEN_TYPE(arg)                                                       \
+    _Generic((arg),                                                                 \
+             long long: RT_KTOKEN_INT64,                                            \
+             unsigned long long: RT_KTOKEN_INT64,                                   \
+             float: RT_KTOKEN_FLOAT,                                               \
+             double: RT_KTOKEN_DOUBLE,                                              \
+             char *: RT_KTOKEN_STRING,                                              \
+             const char *: RT_KTOKEN_STRING,                                        \
+             default: RT_KTOKEN_INT)
+
+#define __RT_KTOKEN_COUNT(...)                                                      \
+    __RT_KTOKEN_COUNT_(0, ##__VA_ARGS__, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define __RT_KTOKEN_COUNT_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, n, ...) n
+
+#define __RT_KTOKEN_CONCAT(a, b)        __RT_KTOKEN_CONCAT_(a, b)
+#define __RT_KTOKEN_CONCAT_(a, b)       a##b
+
+/* the type of the first argument in bits 4-6, the next in bits 7-9... */
+#define __RT_KTOKEN_T0()                0
+#define __RT_KTOKEN_T1(a)               (__RT_KTOKEN_TYPE(a) << 4)
+#define __RT_KTOKEN_T2(a, ...)          (__RT_KTOKEN_T1(a) | (__RT_KTOKEN_T1(__VA_ARGS__) << 3))
+#define __RT_KTOKEN_T3(a, ...)          (__RT_KTOKEN_T1(a) | (__RT_KTOKEN_T2(__VA_ARGS__) << 3))
+#define __RT_KTOKEN_T4(a, ...)          (__RT_KTOKEN_T1(a) | (__RT_KTOKEN_T3(__VA_ARGS__) << 3))
+#define __RT_KTOKEN_T5(a, ...)          (__RT_KTOKEN_T1(a) | (__RT_KTOKEN_T4(__VA_ARGS__) << 3))
+#define __RT_KTOKEN_T6(a, ...)          (__RT_KTOKEN_T1(a) | (__RT_KTOKEN_T5(__VA_ARGS__) << 3))
+#define __RT_KTOKEN_T7(a, ...)          (__RT_KTOKEN_T1(a) | (__RT_KTOKEN_T6(__VA_ARGS__) << 3))
+#define __RT_KTOKEN_T8(a, ...)          (__RT_KTOKEN_T1(a) | (__RT_KTOKEN_T7(__VA_ARGS__) << 3))
+#define __RT_KTOKEN_T9(a, ...)          (__RT_KTOKEN_T1(a) | (__RT_KTOKEN_T8(__VA_ARGS__) << 3))
+
+#define RT_KTOKEN_TYPES(...)                                                        \
+    (__RT_KTOKEN_COUNT(__VA_ARGS__) |                                               \
+     __RT_KTOKEN_CONCAT(__RT_KTOKEN_T, __RT_KTOKEN_COUNT(__VA_ARGS__))(__VA_ARGS__))
+
+/* the format and argument types of a call, kept in rt_ktoken section */
+#define RT_KTOKEN(fmt, ...)                                                         \
+    ({                                                                              \
+        static const struct rt_ktoken __rt_ktoken SECTION("rt_ktoken") =           \
+            {RT_KTOKEN_TYPES(__VA_ARGS__), fmt};                                    \
+        &__rt_ktoken;                                                               \
+    })
+
+#define rt_ktoken_printf(fmt, ...)                                                  \
+    rt_ktoken_print(RT_KTOKEN(fmt, ##__VA_ARGS__), ##__VA_ARGS__)
+
+rt_size_t rt_ktoken_vencode(rt_uint8_t *buf, rt_size_t size, const struct rt_ktoken *token, va_list args);
+rt_size_t rt_ktoken_encode(rt_uint8_t *buf, rt_size_t size, const struct rt_ktoken *token, ...);
+void rt_ktoken_print(const struct rt_ktoken *token, ...);
+#else
+#define rt_ktoken_printf(fmt, ...)      rt_kprintf(fmt, ##__VA_ARGS__)
+#endif
+
+#ifdef RT_USING_DBG_RUNTIME_LEVEL
+rt_size_t rt_dbg_level_set(const char *tag, rt_uint8_t level);
+int rt_dbg_level_get(const char *tag);
+#endif
+#ifdef RT_USING_DBG_RATELIMIT
+rt_bool_t rt_dbg_ratelimit(struct rt_dbg_ratelimit *rl, const char *tag);
 #endif
 rt_int32_t rt_vsprintf(char *dest, const char *format, va_list arg_ptr);
 rt_int32_t rt_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args);
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * Arena allocator.
+ *
+ * An arena hands out scratch buffers from a fixed memory block by bumping a
+ * pointer. The buffers are never released one by one: the whole arena is
+ * reset at the end of a processing cycle, or rolled back to a checkpoint
+ * taken by rt_arena_save().
+ *
+ * An arena is owned by one thread and has no lock, so neither allocation nor
+ * reset touches the system heap.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_ARENA
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * This function will initialize an arena on a memory block.
+ *
+ * @param arena the arena object
+ * @param start the start address of memory block
+ * @param size the size of memory block
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_arena_init(struct rt_arena *arena, void *start, rt_size_t size)
+{
+    rt_uint8_t *begin, *end;
+
+    RT_ASSERT(arena != RT_NULL);
+    RT_ASSERT(start != RT_NULL);
+
+    begin = (rt_uint8_t *)RT_ALIGN((rt_ubase_t)start, RT_ALIGN_SIZE);
+    end   = (rt_uint8_t *)RT_ALIGN_DOWN((rt_ubase_t)start + size, RT_ALIGN_SIZE);
+    if (end < begin)
+        end = begin;
+
+    arena->start_addr = begin;
+    arena->ptr        = begin;
+    arena->end        = end;
+    arena->max_used   = 0;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_arena_init);
+
+#ifdef RT_USING_HEAP
+/**
+ * This function will create an arena with a memory block allocated from
+ * system heap.
+ *
+ * @param size the size of arena
+ *
+ * @return the created arena, RT_NULL on error
+ */
+rt_arena_t rt_arena_create(rt_size_t size)
+{
+    struct rt_arena *arena;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* the arena object and its memory block in one allocation */
+    arena = (struct rt_arena *)rt_malloc(RT_ALIGN(sizeof(struct rt_arena), RT_ALIGN_SIZE) +
+                                         RT_ALIGN(size, RT_ALIGN_SIZE));
+    if (arena == RT_NULL)
+        return RT_NULL;
+
+    rt_arena_init(arena,
+                  (rt_uint8_t *)arena + RT_ALIGN(sizeof(struct rt_arena), RT_ALIGN_SIZE),
+                  RT_ALIGN(size, RT_ALIGN_SIZE));
+
+    return arena;
+}
+RTM_EXPORT(rt_arena_create);
+
+/**
+ * This function will delete an arena created by rt_arena_create. All of
+ * buffers allocated from the arena are released.
+ *
+ * @param arena the arena object
+ */
+void rt_arena_delete(rt_arena_t arena)
+{
+    RT_DEBUG_NOT_IN_INTERRUPT;
+    RT_ASSERT(arena != RT_NULL);
+
+    rt_free(arena);
+}
+RTM_EXPORT(rt_arena_delete);
+#endif
+
+/**
+ * This function will allocate a buffer from an arena. The buffer is aligned
+ * to RT_ALIGN_SIZE.
+ *
+ * @param arena the arena object
+ * @param size the size of buffer
+ *
+ * @return the allocated buffer, RT_NULL if the arena is exhausted
+ */
+void *rt_arena_alloc(rt_arena_t arena, rt_size_t size)
+{
+    rt_uint8_t *ptr;
+
+    RT_ASSERT(arena != RT_NULL);
+
+    size = RT_ALIGN(size, RT_ALIGN_SIZE);
+    if (size > (rt_size_t)(arena->end - arena->ptr))
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("arena exhausted, size %d\n", size));
+
+        return RT_NULL;
+    }
+
+    ptr = arena->ptr;
+    arena->ptr = ptr + size;
+    if (arena->max_used < (rt_size_t)(arena->ptr - arena->start_addr))
+        arena->max_used = arena->ptr - arena->start_addr;
+
+    return ptr;
+}
+RTM_EXPORT(rt_arena_alloc);
+
+/**
+ * This function will release all of buffers allocated from an arena.
+ *
+ * @param arena the arena object
+ */
+void rt_arena_reset(rt_arena_t arena)
+{
+    RT_ASSERT(arena != RT_NULL);
+
+    arena->ptr = arena->start_addr;
+}
+RTM_EXPORT(rt_arena_reset);
+
+/**
+ * This function will take a checkpoint of an arena.
+ *
+ * @param arena the arena object
+ *
+ * @return the checkpoint, which can be passed to rt_arena_restore
+ */
+rt_arena_mark_t rt_arena_save(rt_arena_t arena)
+{
+    RT_ASSERT(arena != RT_NULL);
+
+    return arena->ptr;
+}
+RTM_EXPORT(rt_arena_save);
+
+/**
+ * This function will release the buffers allocated from an arena after a
+ * checkpoint. The checkpoints taken after this one become invalid.
+ *
+ * @param arena the arena object
+ * @param mark the checkpoint returned by rt_arena_save
+ */
+void rt_arena_restore(rt_arena_t arena, rt_arena_mark_t mark)
+{
+    RT_ASSERT(arena != RT_NULL);
+    RT_ASSERT(mark >= arena->start_addr && mark <= arena->ptr);
+
+    arena->ptr = mark;
+}
+RTM_EXPORT(rt_arena_restore);
+
+/**
+ * This function will return the usage of an arena.
+ *
+ * @param arena the arena object
+ * @param total the size of arena
+ * @param used the bytes allocated since the last reset
+ * @param max_used the maximum bytes allocated
+ */
+void rt_arena_info(rt_arena_t arena,
+                   rt_uint32_t *total,
+                   rt_uint32_t *used,
+                   rt_uint32_t *max_used)
+{
+    RT_ASSERT(arena != RT_NULL);
+
+    if (total != RT_NULL)
+        *total = arena->end - arena->start_addr;
+    if (used != RT_NULL)
+        *used = arena->ptr - arena->start_addr;
+    if (max_used != RT_NULL)
+        *max_used = arena->max_used;
+}
+RTM_EXPORT(rt_arena_info);
+
+/**@}*/
+
+#endif /* end of RT_USING_ARENA */
@@ -12,6 +12,8 @@
  * 2010-05-20     Bernard      fix the tick exceeds the maximum limits
  * 2010-07-13     Bernard      fix rt_tick_from_millisecond issue found by kuronca
  * 2011-06-26     Bernard      add rt_tick_set function.
+ * 2026-10-19     tangmenglin  charge the tick to CPU budget of thread.
+ * 2026-10-19     tangmenglin  release slots of cyclic executive.
  */
 
 #include <rthw.h>
@@ -74,6 +76,11 @@ void rt_tick_increase(void)
     /* check time slice */
     thread = rt_thread_self();
 
+#ifdef RT_USING_THREAD_BUDGET
+    /* which may throttle the thread */
+    rt_thread_budget_charge(thread);
+#endif
+
     -- thread->remaining_tick;
     if (thread->remaining_tick == 0)
     {
@@ -84,6 +91,11 @@ void rt_tick_increase(void)
         rt_thread_yield();
     }
 
+#ifdef RT_USING_CYCLIC
+    /* time-triggered slots */
+    rt_cyclic_tick();
+#endif
+
     /* check timer */
     rt_timer_check();
 }
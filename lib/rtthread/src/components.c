@@ -14,6 +14,7 @@
  * 2015-05-04     Bernard      Rename it to components.c because compiling issue
  *                             in some IDEs.
  * 2015-07-29     Arda.Fu      Add support to use RT_USING_USER_MAIN with IAR
+ * 2026-10-19     tangmenglin  Add the level of statically defined kernel objects
  */
 
 #include <rthw.h>
@@ -36,11 +37,12 @@
  * BOARD_EXPORT      --> 1
  * rti_board_end     --> 1.end
  *
+ * OBJECT_EXPORT     --> 1.obj (RT_SEM_DEFINE, RT_MQ_DEFINE)
  * DEVICE_EXPORT     --> 2
  * COMPONENT_EXPORT  --> 3
  * FS_EXPORT         --> 4
  * ENV_EXPORT        --> 5
- * APP_EXPORT        --> 6
+ * APP_EXPORT        --> 6 (RT_THREAD_DEFINE)
  *
  * rti_end           --> 6.end
  *
@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018/10/28     Bernard      The unify RISC-V porting code.
+ * 2026-10-19     tangmenglin  add __rt_ffs by ctz.
+ * 2026-10-19     tangmenglin  add rt_hw_cycle_get.
  */
 
 #include <rthw.h>
@@ -115,6 +117,41 @@ void rt_hw_context_switch_interrupt(rt_ubase_t from, rt_ubase_t to)
 }
 #endif /* end of RT_USING_SMP */
 
+/**
+ * This function will return the low 32 bits of mcycle, the cycle counter of
+ * CPU, for the timing finer than tick.
+ *
+ * @return the cycle count
+ */
+rt_uint32_t rt_hw_cycle_get(void)
+{
+    rt_uint32_t cycles;
+
+    __asm__ volatile ("csrr %0, mcycle" : "=r"(cycles));
+
+    return cycles;
+}
+
+#ifdef RT_USING_CPU_FFS
+/**
+ * This function finds the first bit set (beginning with the least significant bit)
+ * in value and return the index of that bit.
+ *
+ * __builtin_ctz is the ctz instruction of Zbb. Without Zbb, it is a call to
+ * libgcc, then the lookup table of kservice.c is usually faster.
+ *
+ * @return return the index of the first bit set. If value is 0, then this function
+ * shall return 0.
+ */
+int __rt_ffs(int value)
+{
+    if (value == 0)
+        return 0;
+
+    return __builtin_ctz(value) + 1;
+}
+#endif
+
 /** shutdown CPU */
 void rt_hw_cpu_shutdown()
 {
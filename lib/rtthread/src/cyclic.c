@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ * 2026-10-19     tangmenglin  enforce the budget of thread slots.
+ */
+
+/*
+ * Time-triggered cyclic executive.
+ *
+ * The schedule is a table of slots fixed at compile time, each defined by
+ * RT_CYCLIC_SLOT in the rt_cyclic_slot section. A major frame lasts
+ * RT_CYCLIC_MAJOR_FRAME ticks. At the offset tick of a slot in each frame,
+ * the tick interrupt either calls the slot function or resumes the slot
+ * thread, which waits for its releases in rt_cyclic_wait(). Slot threads
+ * should have the highest priorities in the system, then the threads
+ * scheduled by priority run in the slack left between the slots. A slot
+ * thread blocks nowhere else, as the tick resumes it from any suspension
+ * while none of its jobs is running.
+ *
+ * For each slot, the cycles from the tick to the start of its job are
+ * recorded. Their range is the jitter of the slot. A thread slot overruns
+ * if its job still runs budget ticks after the release: the thread is
+ * suspended then, so it does not take the slack of the other threads, and
+ * its job goes on at the next release of one of its slots, with the budget
+ * of that slot. A slot skips a release if the job of the previous one has
+ * not finished yet.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_CYCLIC
+
+#ifndef RT_CYCLIC_MAJOR_FRAME
+#define RT_CYCLIC_MAJOR_FRAME       10
+#endif
+
+/* the slots, defined by linker for the section */
+extern struct rt_cyclic_slot __start_rt_cyclic_slot[];
+extern struct rt_cyclic_slot __stop_rt_cyclic_slot[];
+
+static rt_bool_t _cyclic_started;
+static rt_tick_t _cyclic_frame_tick;
+static rt_uint32_t _cyclic_frames;
+
+/* it must be invoked with interrupt disabled */
+static void _rt_cyclic_job_start(struct rt_cyclic_slot *slot)
+{
+    rt_uint32_t latency;
+
+    latency = rt_hw_cycle_get() - slot->release;
+    if (latency < slot->latency_min)
+        slot->latency_min = latency;
+    if (latency > slot->latency_max)
+        slot->latency_max = latency;
+    slot->runs ++;
+}
+
+/* the slot in which the job of a thread is running, RT_NULL for none */
+static struct rt_cyclic_slot *_rt_cyclic_thread_busy(struct rt_thread *thread)
+{
+    struct rt_cyclic_slot *slot;
+
+    for (slot = __start_rt_cyclic_slot; slot < __stop_rt_cyclic_slot; slot++)
+    {
+        if (slot->thread == thread && slot->running)
+            return slot;
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * @addtogroup Thread
+ */
+
+/**@{*/
+
+/**
+ * This function will start the cyclic executive. The next tick is the
+ * beginning of a major frame. The statistics of slots are reset.
+ */
+void rt_cyclic_start(void)
+{
+    struct rt_cyclic_slot *slot;
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    for (slot = __start_rt_cyclic_slot; slot < __stop_rt_cyclic_slot; slot++)
+    {
+        RT_ASSERT(slot->offset < RT_CYCLIC_MAJOR_FRAME);
+        RT_ASSERT(slot->budget < RT_CYCLIC_MAJOR_FRAME);
+        RT_ASSERT(slot->entry != RT_NULL || slot->thread != RT_NULL);
+
+        slot->latency_min = ~0u;
+        slot->latency_max = 0;
+        slot->runs        = 0;
+        slot->overruns    = 0;
+        slot->skips       = 0;
+        slot->running     = 0;
+        slot->throttled   = 0;
+    }
+
+    _cyclic_frame_tick = RT_CYCLIC_MAJOR_FRAME - 1;
+    _cyclic_frames     = 0;
+    _cyclic_started    = RT_TRUE;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_cyclic_start);
+
+/**
+ * This function will stop the cyclic executive. The slot threads stay in
+ * rt_cyclic_wait().
+ */
+void rt_cyclic_stop(void)
+{
+    _cyclic_started = RT_FALSE;
+}
+RTM_EXPORT(rt_cyclic_stop);
+
+/**
+ * This function will release the slots at the current tick of major frame.
+ * It is invoked by rt_tick_increase.
+ */
+void rt_cyclic_tick(void)
+{
+    struct rt_cyclic_slot *slot, *busy;
+    rt_bool_t need_schedule = RT_FALSE;
+    rt_tick_t elapsed;
+    rt_uint32_t now;
+
+    if (!_cyclic_started)
+        return;
+
+    if (++ _cyclic_frame_tick == RT_CYCLIC_MAJOR_FRAME)
+    {
+        _cyclic_frame_tick = 0;
+        _cyclic_frames ++;
+    }
+
+    now = rt_hw_cycle_get();
+    for (slot = __start_rt_cyclic_slot; slot < __stop_rt_cyclic_slot; slot++)
+    {
+        if (slot->thread != RT_NULL && slot->running && !slot->throttled && slot->budget != 0)
+        {
+            /* the job runs out of its budget, it waits for the next release */
+            elapsed = (_cyclic_frame_tick + RT_CYCLIC_MAJOR_FRAME - slot->offset) % RT_CYCLIC_MAJOR_FRAME;
+            if (elapsed == slot->budget)
+            {
+                slot->overruns ++;
+                if (rt_thread_suspend(slot->thread) == RT_EOK)
+                {
+                    slot->throttled = 1;
+                    need_schedule = RT_TRUE;
+                }
+            }
+        }
+
+        if (slot->offset != _cyclic_frame_tick)
+            continue;
+
+        slot->release = now;
+        if (slot->entry != RT_NULL)
+        {
+            _rt_cyclic_job_start(slot);
+            slot->entry();
+        }
+        else
+        {
+            busy = _rt_cyclic_thread_busy(slot->thread);
+            if (busy != RT_NULL && busy->throttled)
+            {
+                /* the job out of budget goes on in this slot, no new job */
+                busy->running   = 0;
+                busy->throttled = 0;
+                slot->running   = 1;
+                slot->skips ++;
+                rt_thread_resume(slot->thread);
+                need_schedule = RT_TRUE;
+            }
+            else if (busy != RT_NULL || rt_thread_resume(slot->thread) != RT_EOK)
+            {
+                /* the previous job has not finished */
+                slot->skips ++;
+            }
+            else
+            {
+                slot->running = 1;
+                need_schedule = RT_TRUE;
+            }
+        }
+    }
+
+    if (need_schedule)
+        rt_schedule();
+}
+
+/**
+ * This function will finish the job of current thread in its slot, and wait
+ * for the next release of the slots of thread.
+ *
+ * @return the slot released
+ */
+struct rt_cyclic_slot *rt_cyclic_wait(void)
+{
+    struct rt_cyclic_slot *slot;
+    struct rt_thread *thread;
+    register rt_base_t level;
+
+    RT_DEBUG_IN_THREAD_CONTEXT;
+
+    thread = rt_thread_self();
+
+    level = rt_hw_interrupt_disable();
+    for (slot = __start_rt_cyclic_slot; slot < __stop_rt_cyclic_slot; slot++)
+    {
+        if (slot->thread == thread)
+            slot->running = 0;
+    }
+
+    rt_thread_suspend(thread);
+    rt_hw_interrupt_enable(level);
+
+    rt_schedule();
+
+    /* released by the tick */
+    level = rt_hw_interrupt_disable();
+    for (slot = __start_rt_cyclic_slot; slot < __stop_rt_cyclic_slot; slot++)
+    {
+        if (slot->thread == thread && slot->running)
+        {
+            _rt_cyclic_job_start(slot);
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return slot < __stop_rt_cyclic_slot ? slot : RT_NULL;
+}
+RTM_EXPORT(rt_cyclic_wait);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+int list_cyclic(void)
+{
+    struct rt_cyclic_slot *slot;
+
+    rt_kprintf("major frame %d ticks, %d frames\n", RT_CYCLIC_MAJOR_FRAME, _cyclic_frames);
+    rt_kprintf("slot             offset budget     runs  min cyc  max cyc   jitter overrun skip\n");
+    rt_kprintf("---------------- ------ ------ -------- -------- -------- -------- ------- ----\n");
+    for (slot = __start_rt_cyclic_slot; slot < __stop_rt_cyclic_slot; slot++)
+    {
+        rt_kprintf("%-16s %6d %6d %8d %8d %8d %8d %7d %4d\n", slot->name,
+                   slot->offset, slot->budget, slot->runs,
+                   slot->runs ? slot->latency_min : 0, slot->latency_max,
+                   slot->runs ? slot->latency_max - slot->latency_min : 0,
+                   slot->overruns, slot->skips);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_cyclic, list slots of cyclic executive);
+#endif /* end of RT_USING_FINSH */
+
+#endif /* end of RT_USING_CYCLIC */
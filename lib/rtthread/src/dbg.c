@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ * 2026-10-19     tangmenglin  a sentinel module, so the section always exists.
+ */
+
+/*
+ * Runtime control of rtdbg logs.
+ *
+ * Each file including rtdbg.h places a struct rt_dbg_module, its tag and
+ * level, in the rt_dbg_module section. LOG_X compares its level with the one
+ * of module before printing, so a module can be quietened or made verbose
+ * again from the shell without rebuilding. Only the levels compiled in, see
+ * DBG_LVL and RT_DBG_LEVEL_FLOOR, can be enabled.
+ *
+ * Each LOG_X call site may also keep a struct rt_dbg_ratelimit, which lets
+ * RT_DBG_RATELIMIT_BURST logs through per RT_DBG_RATELIMIT_INTERVAL ticks.
+ * A log flooding from a hot path costs a tick read and a compare once the
+ * burst is spent.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifndef RT_DBG_RATELIMIT_BURST
+#define RT_DBG_RATELIMIT_BURST      10
+#endif
+
+#ifndef RT_DBG_RATELIMIT_INTERVAL
+#define RT_DBG_RATELIMIT_INTERVAL   RT_TICK_PER_SECOND
+#endif
+
+#ifdef RT_USING_DBG_RUNTIME_LEVEL
+/* the modules, defined by linker for the section */
+extern struct rt_dbg_module __start_rt_dbg_module[];
+extern struct rt_dbg_module __stop_rt_dbg_module[];
+
+/*
+ * the linker defines the bounds only if the section exists, which needs a
+ * file including rtdbg.h. The sentinel, without tag, makes it always exist.
+ */
+RT_USED static struct rt_dbg_module _dbg_sentinel SECTION("rt_dbg_module") =
+{
+    RT_NULL, 0, 0
+};
+#endif
+
+/**
+ * @addtogroup KernelService
+ */
+
+/**@{*/
+
+#ifdef RT_USING_DBG_RUNTIME_LEVEL
+/**
+ * This function will set the log level of modules at runtime. A level more
+ * verbose than the one compiled in a module is lowered to it.
+ *
+ * @param tag the DBG_TAG of modules, RT_NULL for all of modules
+ * @param level the log level, DBG_ERROR to DBG_LOG
+ *
+ * @return the number of modules set
+ */
+rt_size_t rt_dbg_level_set(const char *tag, rt_uint8_t level)
+{
+    struct rt_dbg_module *module;
+    rt_size_t count = 0;
+
+    for (module = __start_rt_dbg_module; module < __stop_rt_dbg_module; module++)
+    {
+        if (module->tag == RT_NULL)
+            continue;
+        if (tag != RT_NULL && rt_strcmp(module->tag, tag) != 0)
+            continue;
+
+        module->level = level < module->compiled ? level : module->compiled;
+        count++;
+    }
+
+    return count;
+}
+RTM_EXPORT(rt_dbg_level_set);
+
+/**
+ * This function will return the log level of a module at runtime.
+ *
+ * @param tag the DBG_TAG of module
+ *
+ * @return the log level, -RT_ERROR if there is no such module
+ */
+int rt_dbg_level_get(const char *tag)
+{
+    struct rt_dbg_module *module;
+
+    RT_ASSERT(tag != RT_NULL);
+
+    for (module = __start_rt_dbg_module; module < __stop_rt_dbg_module; module++)
+    {
+        if (module->tag != RT_NULL && rt_strcmp(module->tag, tag) == 0)
+            return module->level;
+    }
+
+    return -RT_ERROR;
+}
+RTM_EXPORT(rt_dbg_level_get);
+#endif
+
+#ifdef RT_USING_DBG_RATELIMIT
+/**
+ * This function will check the rate limit of a log call site. It is called
+ * by LOG_X before printing.
+ *
+ * @param rl the rate limit state of call site
+ * @param tag the DBG_TAG of call site, to report suppressed logs
+ *
+ * @return RT_TRUE if the log can be printed
+ */
+rt_bool_t rt_dbg_ratelimit(struct rt_dbg_ratelimit *rl, const char *tag)
+{
+    rt_base_t level;
+    rt_tick_t tick;
+    rt_uint16_t suppressed = 0;
+    rt_bool_t pass = RT_TRUE;
+
+    tick = rt_tick_get();
+
+    level = rt_hw_interrupt_disable();
+    /* a new interval */
+    if (rl->count == 0 || tick - rl->begin >= RT_DBG_RATELIMIT_INTERVAL)
+    {
+        suppressed = rl->suppressed;
+        rl->begin = tick;
+        rl->count = 0;
+        rl->suppressed = 0;
+    }
+
+    if (rl->count < RT_DBG_RATELIMIT_BURST)
+        rl->count++;
+    else
+    {
+        if (rl->suppressed != 0xffff)
+            rl->suppressed++;
+        pass = RT_FALSE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (suppressed)
+        rt_kprintf("[%s] %d logs suppressed\n", tag, suppressed);
+
+    return pass;
+}
+RTM_EXPORT(rt_dbg_ratelimit);
+#endif
+
+/**@}*/
+
+#if defined(RT_USING_FINSH) && defined(RT_USING_DBG_RUNTIME_LEVEL)
+#include <finsh.h>
+
+static const char dbg_level_name[] = "EWID";
+
+int dbglvl(int argc, char **argv)
+{
+    struct rt_dbg_module *module;
+    const char *tag;
+    int level;
+
+    if (argc == 1)
+    {
+        rt_kprintf("module           level compiled\n");
+        rt_kprintf("---------------- ----- --------\n");
+        for (module = __start_rt_dbg_module; module < __stop_rt_dbg_module; module++)
+        {
+            if (module->tag == RT_NULL)
+                continue;
+
+            rt_kprintf("%-16s   %c       %c\n", module->tag,
+                       dbg_level_name[module->level], dbg_level_name[module->compiled]);
+        }
+
+        return 0;
+    }
+
+    if (argc == 3)
+    {
+        /* a digit or the letter of level */
+        for (level = 0; level < 4; level++)
+        {
+            if (argv[2][0] == '0' + level || argv[2][0] == dbg_level_name[level] ||
+                argv[2][0] == dbg_level_name[level] + 'a' - 'A')
+                break;
+        }
+
+        tag = rt_strcmp(argv[1], "*") == 0 ? RT_NULL : argv[1];
+        if (level < 4 && argv[2][1] == '\0')
+        {
+            if (rt_dbg_level_set(tag, level) == 0)
+            {
+                rt_kprintf("no module %s\n", argv[1]);
+                return -RT_ERROR;
+            }
+
+            return 0;
+        }
+    }
+
+    rt_kprintf("usage: dbglvl [tag|* E|W|I|D]\n");
+
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(dbglvl, list or set log level of rtdbg modules);
+#endif /* end of RT_USING_FINSH */
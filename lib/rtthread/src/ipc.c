@@ -32,6 +32,10 @@
  * 2010-11-10     Bernard      add IPC reset command implementation.
  * 2011-12-18     Bernard      add more parameter checking in message queue
  * 2013-09-14     Grissiom     add an option check in rt_event_recv
+ * 2026-10-19     tangmenglin  allow anonymous IPC objects
+ * 2026-10-19     tangmenglin  hand CPU over to the thread woken by semaphore
+ *                             release and message queue send
+ * 2026-10-19     tangmenglin  check the message size of message queue
  */
 
 #include <rtthread.h>
@@ -144,6 +148,27 @@ rt_inline rt_err_t rt_ipc_list_resume(rt_list_t *list)
     return RT_EOK;
 }
 
+#ifdef RT_USING_IPC_HANDOFF
+/**
+ * This function will resume the first thread in a list and hand CPU over to
+ * it if it is the next thread, see rt_schedule_handoff.
+ *
+ * @param list the thread list
+ * @param level the interrupt level, the interrupt is enabled on return
+ */
+rt_inline void rt_ipc_list_handoff(rt_list_t *list, rt_base_t level)
+{
+    struct rt_thread *thread;
+
+    /* get thread entry */
+    thread = rt_list_entry(list->next, struct rt_thread, tlist);
+
+    RT_DEBUG_LOG(RT_DEBUG_IPC, ("handoff to thread:%s\n", thread->name));
+
+    rt_schedule_handoff(thread, level);
+}
+#endif
+
 /**
  * This function will resume all suspended threads in a list, including
  * suspend list of IPC object and private list of mailbox etc.
@@ -188,7 +213,8 @@ rt_inline rt_err_t rt_ipc_list_resume_all(rt_list_t *list)
  * resource management.
  *
  * @param sem the semaphore object
- * @param name the name of semaphore
+ * @param name the name of semaphore, RT_NULL for an anonymous semaphore which is
+ *        not put in object container
  * @param value the init value of semaphore
  * @param flag the flag of semaphore
  *
@@ -451,9 +477,16 @@ rt_err_t rt_sem_release(rt_sem_t sem)
 
     if (!rt_list_isempty(&sem->parent.suspend_thread))
     {
+#ifdef RT_USING_IPC_HANDOFF
+        /* resume the suspended thread and switch to it */
+        rt_ipc_list_handoff(&(sem->parent.suspend_thread), temp);
+
+        return RT_EOK;
+#else
         /* resume the suspended thread */
         rt_ipc_list_resume(&(sem->parent.suspend_thread));
         need_schedule = RT_TRUE;
+#endif
     }
     else
         sem->value ++; /* increase value */
@@ -520,7 +553,8 @@ RTM_EXPORT(rt_sem_control);
  * management.
  *
  * @param mutex the mutex object
- * @param name the name of mutex
+ * @param name the name of mutex, RT_NULL for an anonymous mutex which is
+ *        not put in object container
  * @param flag the flag of mutex
  *
  * @return the operation status, RT_EOK on successful
@@ -905,7 +939,8 @@ RTM_EXPORT(rt_mutex_control);
  * management.
  *
  * @param event the event object
- * @param name the name of event
+ * @param name the name of event, RT_NULL for an anonymous event which is
+ *        not put in object container
  * @param flag the flag of event
  *
  * @return the operation status, RT_EOK on successful
@@ -1282,7 +1317,8 @@ RTM_EXPORT(rt_event_control);
  * management.
  *
  * @param mb the mailbox object
- * @param name the name of mailbox
+ * @param name the name of mailbox, RT_NULL for an anonymous mailbox which is
+ *        not put in object container
  * @param msgpool the begin address of buffer to save received mail
  * @param size the size of mailbox
  * @param flag the flag of mailbox
@@ -1758,17 +1794,29 @@ RTM_EXPORT(rt_mb_control);
 #endif /* end of RT_USING_MAILBOX */
 
 #ifdef RT_USING_MESSAGEQUEUE
+/*
+ * Two layouts of message pool are supported. By default each message is an
+ * aligned slot with a link header, and the free and queued messages are kept
+ * in lists. With RT_USING_MESSAGEQUEUE_RING, the pool is an array of fixed
+ * size slots without link used as a ring, like the mailbox. The ring has no
+ * per-message overhead, which suits tiny messages, but the message is copied
+ * with interrupt disabled, so the interrupt latency grows with msg_size. It
+ * is left off by default.
+ */
+#ifndef RT_USING_MESSAGEQUEUE_RING
 struct rt_mq_message
 {
     struct rt_mq_message *next;
 };
+#endif
 
 /**
  * This function will initialize a message queue and put it under control of
  * resource management.
  *
  * @param mq the message object
- * @param name the name of message queue
+ * @param name the name of message queue, RT_NULL for an anonymous message queue which is
+ *        not put in object container
  * @param msgpool the beginning address of buffer to save messages
  * @param msg_size the maximum size of message
  * @param pool_size the size of buffer to save messages
@@ -1783,11 +1831,14 @@ rt_err_t rt_mq_init(rt_mq_t     mq,
                     rt_size_t   pool_size,
                     rt_uint8_t  flag)
 {
+#ifndef RT_USING_MESSAGEQUEUE_RING
     struct rt_mq_message *head;
+#endif
     register rt_base_t temp;
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(msg_size != 0);
 
     /* init object */
     rt_object_init(&(mq->parent.parent), RT_Object_Class_MessageQueue, name);
@@ -1801,6 +1852,16 @@ rt_err_t rt_mq_init(rt_mq_t     mq,
     /* set messasge pool */
     mq->msg_pool = msgpool;
 
+#ifdef RT_USING_MESSAGEQUEUE_RING
+    /* the slot is as large as the message */
+    mq->msg_size = msg_size;
+    temp = pool_size / msg_size;
+    mq->max_msgs = temp > 0xffff ? 0xffff : temp;
+
+    /* init message ring */
+    mq->in_offset  = 0;
+    mq->out_offset = 0;
+#else
     /* get correct message size */
     mq->msg_size = RT_ALIGN(msg_size, RT_ALIGN_SIZE);
     mq->max_msgs = pool_size / (mq->msg_size + sizeof(struct rt_mq_message));
@@ -1818,6 +1879,7 @@ rt_err_t rt_mq_init(rt_mq_t     mq,
         head->next = mq->msg_queue_free;
         mq->msg_queue_free = head;
     }
+#endif
 
     /* the initial entry is zero */
     mq->entry = 0;
@@ -1867,10 +1929,13 @@ rt_mq_t rt_mq_create(const char *name,
                      rt_uint8_t  flag)
 {
     struct rt_messagequeue *mq;
+#ifndef RT_USING_MESSAGEQUEUE_RING
     struct rt_mq_message *head;
     register rt_base_t temp;
+#endif
 
     RT_DEBUG_NOT_IN_INTERRUPT;
+    RT_ASSERT(msg_size != 0);
 
     /* allocate object */
     mq = (rt_mq_t)rt_object_allocate(RT_Object_Class_MessageQueue, name);
@@ -1885,6 +1950,24 @@ rt_mq_t rt_mq_create(const char *name,
 
     /* init message queue */
 
+#ifdef RT_USING_MESSAGEQUEUE_RING
+    /* the slot is as large as the message */
+    mq->msg_size = msg_size;
+    mq->max_msgs = max_msgs;
+
+    /* allocate message pool */
+    mq->msg_pool = RT_KERNEL_MALLOC(mq->msg_size * mq->max_msgs);
+    if (mq->msg_pool == RT_NULL)
+    {
+        rt_mq_delete(mq);
+
+        return RT_NULL;
+    }
+
+    /* init message ring */
+    mq->in_offset  = 0;
+    mq->out_offset = 0;
+#else
     /* get correct message size */
     mq->msg_size = RT_ALIGN(msg_size, RT_ALIGN_SIZE);
     mq->max_msgs = max_msgs;
@@ -1911,6 +1994,7 @@ rt_mq_t rt_mq_create(const char *name,
         head->next = mq->msg_queue_free;
         mq->msg_queue_free = head;
     }
+#endif
 
     /* the initial entry is zero */
     mq->entry = 0;
@@ -1962,7 +2046,9 @@ RTM_EXPORT(rt_mq_delete);
 rt_err_t rt_mq_send(rt_mq_t mq, void *buffer, rt_size_t size)
 {
     register rt_ubase_t temp;
+#ifndef RT_USING_MESSAGEQUEUE_RING
     struct rt_mq_message *msg;
+#endif
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
@@ -1979,6 +2065,22 @@ rt_err_t rt_mq_send(rt_mq_t mq, void *buffer, rt_size_t size)
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_MESSAGEQUEUE_RING
+    /* message queue is full */
+    if (mq->entry == mq->max_msgs)
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        return -RT_EFULL;
+    }
+
+    /* copy buffer to the slot at ring tail */
+    rt_memcpy((rt_uint8_t *)mq->msg_pool + mq->in_offset * mq->msg_size, buffer, size);
+    mq->in_offset ++;
+    if (mq->in_offset >= mq->max_msgs)
+        mq->in_offset = 0;
+#else
     /* get a free list, there must be an empty item */
     msg = (struct rt_mq_message *)mq->msg_queue_free;
     /* message queue is full */
@@ -2014,6 +2116,7 @@ rt_err_t rt_mq_send(rt_mq_t mq, void *buffer, rt_size_t size)
     /* if the head is empty, set head */
     if (mq->msg_queue_head == RT_NULL)
         mq->msg_queue_head = msg;
+#endif
 
     /* increase message entry */
     mq->entry ++;
@@ -2021,12 +2124,16 @@ rt_err_t rt_mq_send(rt_mq_t mq, void *buffer, rt_size_t size)
     /* resume suspended thread */
     if (!rt_list_isempty(&mq->parent.suspend_thread))
     {
+#ifdef RT_USING_IPC_HANDOFF
+        rt_ipc_list_handoff(&(mq->parent.suspend_thread), temp);
+#else
         rt_ipc_list_resume(&(mq->parent.suspend_thread));
 
         /* enable interrupt */
         rt_hw_interrupt_enable(temp);
 
         rt_schedule();
+#endif
 
         return RT_EOK;
     }
@@ -2052,7 +2159,9 @@ RTM_EXPORT(rt_mq_send);
 rt_err_t rt_mq_urgent(rt_mq_t mq, void *buffer, rt_size_t size)
 {
     register rt_ubase_t temp;
+#ifndef RT_USING_MESSAGEQUEUE_RING
     struct rt_mq_message *msg;
+#endif
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
@@ -2069,6 +2178,22 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, void *buffer, rt_size_t size)
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_MESSAGEQUEUE_RING
+    /* message queue is full */
+    if (mq->entry == mq->max_msgs)
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        return -RT_EFULL;
+    }
+
+    /* copy buffer to the slot in front of ring head */
+    if (mq->out_offset == 0)
+        mq->out_offset = mq->max_msgs;
+    mq->out_offset --;
+    rt_memcpy((rt_uint8_t *)mq->msg_pool + mq->out_offset * mq->msg_size, buffer, size);
+#else
     /* get a free list, there must be an empty item */
     msg = (struct rt_mq_message *)mq->msg_queue_free;
     /* message queue is full */
@@ -2098,6 +2223,7 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, void *buffer, rt_size_t size)
     /* if there is no tail */
     if (mq->msg_queue_tail == RT_NULL)
         mq->msg_queue_tail = msg;
+#endif
 
     /* increase message entry */
     mq->entry ++;
@@ -2141,7 +2267,9 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
 {
     struct rt_thread *thread;
     register rt_ubase_t temp;
+#ifndef RT_USING_MESSAGEQUEUE_RING
     struct rt_mq_message *msg;
+#endif
     rt_uint32_t tick_delta;
 
     /* parameter check */
@@ -2233,6 +2361,20 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
         }
     }
 
+#ifdef RT_USING_MESSAGEQUEUE_RING
+    /* copy message from the slot at ring head */
+    rt_memcpy(buffer, (rt_uint8_t *)mq->msg_pool + mq->out_offset * mq->msg_size,
+              size > mq->msg_size ? mq->msg_size : size);
+    mq->out_offset ++;
+    if (mq->out_offset >= mq->max_msgs)
+        mq->out_offset = 0;
+
+    /* decrease message entry */
+    mq->entry --;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+#else
     /* get message from queue */
     msg = (struct rt_mq_message *)mq->msg_queue_head;
 
@@ -2258,6 +2400,7 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
     mq->msg_queue_free = msg;
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
+#endif
 
     RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
 
@@ -2278,7 +2421,9 @@ RTM_EXPORT(rt_mq_recv);
 rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg)
 {
     rt_ubase_t level;
+#ifndef RT_USING_MESSAGEQUEUE_RING
     struct rt_mq_message *msg;
+#endif
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
@@ -2292,6 +2437,11 @@ rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg)
         /* resume all waiting thread */
         rt_ipc_list_resume_all(&mq->parent.suspend_thread);
 
+#ifdef RT_USING_MESSAGEQUEUE_RING
+        /* release all message in the ring */
+        mq->in_offset  = 0;
+        mq->out_offset = 0;
+#else
         /* release all message in the queue */
         while (mq->msg_queue_head != RT_NULL)
         {
@@ -2308,6 +2458,7 @@ rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg)
             msg->next = (struct rt_mq_message *)mq->msg_queue_free;
             mq->msg_queue_free = msg;
         }
+#endif
 
         /* clean entry */
         mq->entry = 0;
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ * 2026-10-19     tangmenglin  close the section across a context switch.
+ */
+
+/*
+ * Interrupts disabled and scheduler locked time profiler.
+ *
+ * rt_hw_interrupt_disable() of the port calls rt_irqoff_enter() when it
+ * masks the interrupts which were enabled, with the return address of its
+ * caller. rt_hw_interrupt_enable() calls rt_irqoff_leave() when it enables
+ * them again. The nested calls, and the calls in interrupt service routines,
+ * do not change the state and are not measured. In the same way, the
+ * scheduler lock is measured from the outermost rt_enter_critical() to the
+ * rt_exit_critical() which unlocks it.
+ *
+ * The sections are accounted to their call sites in a small hash table for
+ * each kind: number of sections, maximal and total cycles. A call site is a
+ * return address, resolved by addr2line on the firmware image. The sites
+ * found when a table is full are dropped.
+ *
+ * A section opened by a thread may end in another one: the context switch
+ * resumes a new thread, or a thread preempted in an interrupt, by mret with
+ * interrupt enabled. rt_hw_context_switch_exit() closes the section then, so
+ * it is accounted to the call site which opened it, up to the time the next
+ * thread runs. A port whose switch does not do that leaves the section open,
+ * and the next one opened overwrites it, which is counted as dropped.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_IRQOFF_PROFILE
+
+#ifndef RT_IRQOFF_SITES
+#define RT_IRQOFF_SITES             32
+#endif
+
+static struct rt_irqoff_site _irqoff_sites[2][RT_IRQOFF_SITES];
+static rt_uint32_t _irqoff_dropped[2];
+
+/* the open sections, a caller of 0 for none */
+static rt_ubase_t _irqoff_caller[2];
+static rt_uint32_t _irqoff_start[2];
+
+/* it must be invoked with interrupt disabled */
+static void _rt_irqoff_record(int type, rt_ubase_t caller, rt_uint32_t cycles)
+{
+    struct rt_irqoff_site *site;
+    int index, probe;
+
+    index = (caller >> 1) % RT_IRQOFF_SITES;
+    for (probe = 0; probe < RT_IRQOFF_SITES; probe++)
+    {
+        site = &_irqoff_sites[type][index];
+        if (site->caller == caller || site->caller == 0)
+        {
+            site->caller = caller;
+            site->count ++;
+            site->total += cycles;
+            if (cycles > site->max)
+                site->max = cycles;
+
+            return;
+        }
+
+        if (++ index == RT_IRQOFF_SITES)
+            index = 0;
+    }
+
+    _irqoff_dropped[type] ++;
+}
+
+/**
+ * @addtogroup Kernel
+ */
+
+/**@{*/
+
+/**
+ * This function will open a section with interrupt disabled. It is invoked
+ * by rt_hw_interrupt_disable when the interrupt was enabled.
+ *
+ * @param level the interrupt level returned to the caller
+ * @param caller the return address of the caller
+ *
+ * @return the interrupt level
+ *
+ * @note Please do not invoke this function in user application.
+ */
+rt_base_t rt_irqoff_enter(rt_base_t level, rt_ubase_t caller)
+{
+    /* a section was never closed, lost in a context switch */
+    if (_irqoff_caller[RT_IRQOFF_IRQ] != 0)
+        _irqoff_dropped[RT_IRQOFF_IRQ] ++;
+
+    _irqoff_caller[RT_IRQOFF_IRQ] = caller;
+    _irqoff_start[RT_IRQOFF_IRQ]  = rt_hw_cycle_get();
+
+    return level;
+}
+
+/**
+ * This function will close the section with interrupt disabled. It is
+ * invoked by rt_hw_interrupt_enable before the interrupt is enabled, and by
+ * the context switch before a thread resumes with interrupt enabled.
+ *
+ * @note Please do not invoke this function in user application.
+ */
+void rt_irqoff_leave(void)
+{
+    if (_irqoff_caller[RT_IRQOFF_IRQ] == 0)
+        return;
+
+    _rt_irqoff_record(RT_IRQOFF_IRQ, _irqoff_caller[RT_IRQOFF_IRQ],
+                      rt_hw_cycle_get() - _irqoff_start[RT_IRQOFF_IRQ]);
+    _irqoff_caller[RT_IRQOFF_IRQ] = 0;
+}
+
+/**
+ * This function will open a section with scheduler locked. It is invoked by
+ * rt_enter_critical with interrupt disabled, when it locks the scheduler.
+ *
+ * @param caller the return address of the caller of rt_enter_critical
+ *
+ * @note Please do not invoke this function in user application.
+ */
+void rt_irqoff_lock_enter(rt_ubase_t caller)
+{
+    _irqoff_caller[RT_IRQOFF_LOCK] = caller;
+    _irqoff_start[RT_IRQOFF_LOCK]  = rt_hw_cycle_get();
+}
+
+/**
+ * This function will close the section with scheduler locked. It is invoked
+ * by rt_exit_critical with interrupt disabled, when it unlocks the scheduler.
+ *
+ * @note Please do not invoke this function in user application.
+ */
+void rt_irqoff_lock_leave(void)
+{
+    if (_irqoff_caller[RT_IRQOFF_LOCK] == 0)
+        return;
+
+    _rt_irqoff_record(RT_IRQOFF_LOCK, _irqoff_caller[RT_IRQOFF_LOCK],
+                      rt_hw_cycle_get() - _irqoff_start[RT_IRQOFF_LOCK]);
+    _irqoff_caller[RT_IRQOFF_LOCK] = 0;
+}
+
+/**
+ * This function will get the call sites of a kind of section, sorted by the
+ * maximal cycles in descending order.
+ *
+ * @param type RT_IRQOFF_IRQ for interrupt disabled, RT_IRQOFF_LOCK for
+ *        scheduler locked
+ * @param sites the array of call sites copied to
+ * @param nr the size of array
+ *
+ * @return the number of call sites copied
+ */
+int rt_irqoff_get(int type, struct rt_irqoff_site *sites, int nr)
+{
+    struct rt_irqoff_site site;
+    register rt_base_t level;
+    int index, count = 0, i;
+
+    RT_ASSERT(type == RT_IRQOFF_IRQ || type == RT_IRQOFF_LOCK);
+
+    for (index = 0; index < RT_IRQOFF_SITES; index++)
+    {
+        level = rt_hw_interrupt_disable();
+        site = _irqoff_sites[type][index];
+        rt_hw_interrupt_enable(level);
+
+        if (site.caller == 0)
+            continue;
+
+        /* insert in order, the last one falls off when full */
+        for (i = count; i > 0 && sites[i - 1].max < site.max; i--)
+        {
+            if (i < nr)
+                sites[i] = sites[i - 1];
+        }
+        if (i < nr)
+        {
+            sites[i] = site;
+            if (count < nr)
+                count ++;
+        }
+    }
+
+    return count;
+}
+RTM_EXPORT(rt_irqoff_get);
+
+/**
+ * This function will return the number of sections not accounted because
+ * the table of call sites was full, or because they were left open.
+ *
+ * @param type RT_IRQOFF_IRQ or RT_IRQOFF_LOCK
+ *
+ * @return the number of dropped sections
+ */
+rt_uint32_t rt_irqoff_dropped(int type)
+{
+    RT_ASSERT(type == RT_IRQOFF_IRQ || type == RT_IRQOFF_LOCK);
+
+    return _irqoff_dropped[type];
+}
+RTM_EXPORT(rt_irqoff_dropped);
+
+/**
+ * This function will clear the call sites of both kinds.
+ */
+void rt_irqoff_reset(void)
+{
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(_irqoff_sites, 0, sizeof(_irqoff_sites));
+    _irqoff_dropped[RT_IRQOFF_IRQ]  = 0;
+    _irqoff_dropped[RT_IRQOFF_LOCK] = 0;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_irqoff_reset);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define IRQOFF_TOP                  10
+
+static void irqoff_show(int type, const char *title)
+{
+    static struct rt_irqoff_site sites[IRQOFF_TOP];
+    int count, index;
+
+    count = rt_irqoff_get(type, sites, IRQOFF_TOP);
+
+    rt_kprintf("%s, %d dropped\n", title, rt_irqoff_dropped(type));
+    rt_kprintf("caller        count  max cyc  avg cyc total kcyc\n");
+    rt_kprintf("---------- -------- -------- -------- ----------\n");
+    for (index = 0; index < count; index++)
+    {
+        rt_kprintf("0x%08x %8d %8d %8d %10d\n", sites[index].caller,
+                   sites[index].count, sites[index].max,
+                   (rt_uint32_t)(sites[index].total / sites[index].count),
+                   (rt_uint32_t)(sites[index].total >> 10));
+    }
+}
+
+int irqoff(int argc, char **argv)
+{
+    if (argc == 1)
+    {
+        irqoff_show(RT_IRQOFF_IRQ, "interrupts disabled");
+        rt_kprintf("\n");
+        irqoff_show(RT_IRQOFF_LOCK, "scheduler locked");
+        return 0;
+    }
+
+    if (argc == 2 && !rt_strcmp(argv[1], "reset"))
+    {
+        rt_irqoff_reset();
+        return 0;
+    }
+
+    rt_kprintf("usage: irqoff [reset]\n");
+
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(irqoff, top call sites disabling interrupt or locking scheduler: [reset]);
+#endif /* end of RT_USING_FINSH */
+
+#endif /* end of RT_USING_IRQOFF_PROFILE */
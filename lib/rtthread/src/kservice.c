@@ -17,6 +17,11 @@
  * 2013-06-24     Bernard      remove rt_kprintf if RT_USING_CONSOLE is not defined.
  * 2013-09-24     aozima       make sure the device is in STREAM mode when used by rt_kprintf.
  * 2015-07-06     Bernard      Add rt_assert_handler routine.
+ * 2026-10-19     tangmenglin  word-at-a-time memory and string functions.
+ * 2026-10-19     tangmenglin  two digits conversion and floating point format.
+ * 2026-10-19     tangmenglin  asynchronous rt_kprintf.
+ * 2026-10-19     tangmenglin  direct rt_kprintf for bulk output.
+ * 2026-10-19     tangmenglin  exact ties of floating point rounding, '#' of shortest %g.
  */
 
 #include <rtthread.h>
@@ -115,6 +120,48 @@ int *_rt_errno(void)
 }
 RTM_EXPORT(_rt_errno);
 
+#ifndef RT_USING_TINY_SIZE
+/* word-at-a-time helpers of the memory and string functions */
+#define WORD_SIZE           (sizeof(unsigned long))
+#define WORD_MASK           (WORD_SIZE - 1)
+#define WORD_ONES           (~0UL / 0xff)           /* 0x01 in each byte */
+#define WORD_HIGHS          (WORD_ONES << 7)        /* 0x80 in each byte */
+
+/*
+ * merge the tail of word lo and the head of word hi, which are two adjacent
+ * aligned words, into the word starting at byte offset (shift / 8) of lo.
+ */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define WORD_MERGE(lo, hi, shift) \
+    (((lo) << (shift)) | ((hi) >> (WORD_SIZE * 8 - (shift))))
+#else
+#define WORD_MERGE(lo, hi, shift) \
+    (((lo) >> (shift)) | ((hi) << (WORD_SIZE * 8 - (shift))))
+#endif
+
+#ifdef __riscv_zbb
+/* orc.b sets each non-zero byte to 0xff and each zero byte to 0 */
+rt_inline unsigned long word_orc_b(unsigned long w)
+{
+    unsigned long r;
+
+    __asm__ ("orc.b %0, %1" : "=r"(r) : "r"(w));
+
+    return r;
+}
+#endif
+
+/* whether there is a zero byte in a word */
+rt_inline int word_has_zero(unsigned long w)
+{
+#ifdef __riscv_zbb
+    return word_orc_b(w) != ~0UL;
+#else
+    return ((w - WORD_ONES) & ~w & WORD_HIGHS) != 0;
+#endif
+}
+#endif
+
 /**
  * This function will set the content of memory to specified value
  *
@@ -227,56 +274,70 @@ void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
 
     return dst;
 #else
-
-#define UNALIGNED(X, Y) \
-    (((long)X & (sizeof(long) - 1)) | ((long)Y & (sizeof(long) - 1)))
-#define BIGBLOCKSIZE (sizeof(long) << 2)
-#define LITTLEBLOCKSIZE (sizeof(long))
-#define TOO_SMALL(LEN) ((LEN) < BIGBLOCKSIZE)
-
     char *dst_ptr = (char *)dst;
-    char *src_ptr = (char *)src;
-    long *aligned_dst;
-    long *aligned_src;
-    int len = count;
+    const char *src_ptr = (const char *)src;
+    unsigned long *aligned_dst;
+    const unsigned long *aligned_src;
+    unsigned long lo, hi;
+    unsigned int shift;
 
-    /* If the size is small, or either SRC or DST is unaligned,
-    then punt into the byte copy loop.  This should be rare. */
-    if (!TOO_SMALL(len) && !UNALIGNED(src_ptr, dst_ptr))
+    if (count >= WORD_SIZE * 2)
     {
-        aligned_dst = (long *)dst_ptr;
-        aligned_src = (long *)src_ptr;
-
-        /* Copy 4X long words at a time if possible. */
-        while (len >= BIGBLOCKSIZE)
+        /* align the destination with a byte copier */
+        while ((rt_ubase_t)dst_ptr & WORD_MASK)
         {
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            len -= BIGBLOCKSIZE;
+            *dst_ptr++ = *src_ptr++;
+            count --;
         }
 
-        /* Copy one long word at a time if possible. */
-        while (len >= LITTLEBLOCKSIZE)
+        aligned_dst = (unsigned long *)dst_ptr;
+        shift = ((rt_ubase_t)src_ptr & WORD_MASK) * 8;
+        if (shift == 0)
+        {
+            aligned_src = (const unsigned long *)src_ptr;
+
+            /* copy 4X long words at a time if possible */
+            while (count >= WORD_SIZE * 4)
+            {
+                aligned_dst[0] = aligned_src[0];
+                aligned_dst[1] = aligned_src[1];
+                aligned_dst[2] = aligned_src[2];
+                aligned_dst[3] = aligned_src[3];
+                aligned_dst += 4;
+                aligned_src += 4;
+                count -= WORD_SIZE * 4;
+            }
+
+            while (count >= WORD_SIZE)
+            {
+                *aligned_dst++ = *aligned_src++;
+                count -= WORD_SIZE;
+            }
+        }
+        else
         {
-            *aligned_dst++ = *aligned_src++;
-            len -= LITTLEBLOCKSIZE;
+            /* the source is unaligned, merge two aligned source words into
+             * each destination word */
+            aligned_src = (const unsigned long *)(src_ptr - shift / 8);
+            lo = *aligned_src++;
+            while (count >= WORD_SIZE)
+            {
+                hi = *aligned_src++;
+                *aligned_dst++ = WORD_MERGE(lo, hi, shift);
+                lo = hi;
+                count -= WORD_SIZE;
+            }
         }
 
-        /* Pick up any residual with a byte copier. */
+        /* pick up any residual with a byte copier */
+        src_ptr += (char *)aligned_dst - dst_ptr;
         dst_ptr = (char *)aligned_dst;
-        src_ptr = (char *)aligned_src;
     }
 
-    while (len--)
+    while (count--)
         *dst_ptr++ = *src_ptr++;
 
     return dst;
-#undef UNALIGNED
-#undef BIGBLOCKSIZE
-#undef LITTLEBLOCKSIZE
-#undef TOO_SMALL
 #endif
 }
 RTM_EXPORT(rt_memcpy);
@@ -294,19 +355,71 @@ RTM_EXPORT(rt_memcpy);
 void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
 {
     char *tmp = (char *)dest, *s = (char *)src;
+#ifndef RT_USING_TINY_SIZE
+    unsigned long *aligned_dst;
+    const unsigned long *aligned_src;
+    unsigned long lo, hi;
+    unsigned int shift;
+#endif
 
     if (s < tmp && tmp < s + n)
     {
         tmp += n;
         s += n;
 
+#ifndef RT_USING_TINY_SIZE
+        if (n >= WORD_SIZE * 2)
+        {
+            /* align the end of destination with a byte copier */
+            while ((rt_ubase_t)tmp & WORD_MASK)
+            {
+                *(--tmp) = *(--s);
+                n --;
+            }
+
+            aligned_dst = (unsigned long *)tmp;
+            shift = ((rt_ubase_t)s & WORD_MASK) * 8;
+            if (shift == 0)
+            {
+                aligned_src = (const unsigned long *)s;
+                while (n >= WORD_SIZE)
+                {
+                    *(--aligned_dst) = *(--aligned_src);
+                    n -= WORD_SIZE;
+                }
+            }
+            else
+            {
+                /* the same merge as rt_memcpy, from the end */
+                aligned_src = (const unsigned long *)(s - shift / 8);
+                hi = *aligned_src;
+                while (n >= WORD_SIZE)
+                {
+                    lo = *(--aligned_src);
+                    *(--aligned_dst) = WORD_MERGE(lo, hi, shift);
+                    hi = lo;
+                    n -= WORD_SIZE;
+                }
+            }
+
+            s -= tmp - (char *)aligned_dst;
+            tmp = (char *)aligned_dst;
+        }
+#endif
+
         while (n--)
             *(--tmp) = *(--s);
     }
     else
     {
+#ifndef RT_USING_TINY_SIZE
+        /* the forward copy of rt_memcpy reads each word before the words
+         * overlapping it are written */
+        return rt_memcpy(dest, src, n);
+#else
         while (n--)
             *tmp++ = *s++;
+#endif
     }
 
     return dest;
@@ -326,8 +439,78 @@ rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
 {
     const unsigned char *su1, *su2;
     int res = 0;
+#ifndef RT_USING_TINY_SIZE
+    const unsigned long *aligned_s1, *aligned_s2;
+    unsigned long w1 = 0, w2 = 0, lo, hi;
+    unsigned int shift;
+#endif
 
-    for (su1 = cs, su2 = ct; 0 < count; ++su1, ++su2, count--)
+    su1 = cs;
+    su2 = ct;
+#ifndef RT_USING_TINY_SIZE
+    if (count >= WORD_SIZE * 2)
+    {
+        /* align the first area */
+        while ((rt_ubase_t)su1 & WORD_MASK)
+        {
+            if ((res = *su1 - *su2) != 0)
+                return res;
+            su1 ++;
+            su2 ++;
+            count --;
+        }
+
+        /* skip the equal words */
+        aligned_s1 = (const unsigned long *)su1;
+        shift = ((rt_ubase_t)su2 & WORD_MASK) * 8;
+        if (shift == 0)
+        {
+            aligned_s2 = (const unsigned long *)su2;
+            while (count >= WORD_SIZE)
+            {
+                w1 = *aligned_s1;
+                w2 = *aligned_s2;
+                if (w1 != w2)
+                    break;
+                aligned_s1 ++;
+                aligned_s2 ++;
+                count -= WORD_SIZE;
+            }
+        }
+        else
+        {
+            aligned_s2 = (const unsigned long *)(su2 - shift / 8);
+            lo = *aligned_s2++;
+            while (count >= WORD_SIZE)
+            {
+                hi = *aligned_s2;
+                w1 = *aligned_s1;
+                w2 = WORD_MERGE(lo, hi, shift);
+                if (w1 != w2)
+                    break;
+                aligned_s1 ++;
+                aligned_s2 ++;
+                lo = hi;
+                count -= WORD_SIZE;
+            }
+        }
+
+        su2 += (const unsigned char *)aligned_s1 - su1;
+        su1 = (const unsigned char *)aligned_s1;
+#ifdef __riscv_zbb
+        /* RISC-V is little endian, the first different byte is the lowest */
+        if (count >= WORD_SIZE)
+        {
+            shift = __builtin_ctzl(w1 ^ w2) >> 3;
+            su1 += shift;
+            su2 += shift;
+            count -= shift;
+        }
+#endif
+    }
+#endif
+
+    for (; 0 < count; ++su1, ++su2, count--)
         if ((res = *su1 - *su2) != 0)
             break;
 
@@ -434,6 +617,29 @@ rt_int32_t rt_strncmp(const char *cs, const char *ct, rt_ubase_t count)
 {
     register signed char __res = 0;
 
+#ifndef RT_USING_TINY_SIZE
+    /* compare a word at a time when both strings have the same alignment */
+    if ((((rt_ubase_t)cs ^ (rt_ubase_t)ct) & WORD_MASK) == 0)
+    {
+        while (((rt_ubase_t)cs & WORD_MASK) && count)
+        {
+            if ((__res = *cs - *ct++) != 0 || !*cs++)
+                return __res;
+            count--;
+        }
+
+        /* stop at the word which differs or holds the terminator */
+        while (count >= WORD_SIZE &&
+               *(const unsigned long *)cs == *(const unsigned long *)ct &&
+               !word_has_zero(*(const unsigned long *)cs))
+        {
+            cs += WORD_SIZE;
+            ct += WORD_SIZE;
+            count -= WORD_SIZE;
+        }
+    }
+#endif
+
     while (count)
     {
         if ((__res = *cs - *ct++) != 0 || !*cs++)
@@ -495,8 +701,30 @@ RTM_EXPORT(rt_strnlen);
 rt_size_t rt_strlen(const char *s)
 {
     const char *sc;
+#ifndef RT_USING_TINY_SIZE
+    const unsigned long *w;
 
-    for (sc = s; *sc != '\0'; ++sc) /* nothing */
+    for (sc = s; (rt_ubase_t)sc & WORD_MASK; ++sc)
+    {
+        if (*sc == '\0')
+            return sc - s;
+    }
+
+    /* an aligned word never crosses the end of memory */
+    for (w = (const unsigned long *)sc; !word_has_zero(*w); w++) /* nothing */
+        ;
+
+#ifdef __riscv_zbb
+    /* RISC-V is little endian, the first zero byte is the lowest */
+    return (const char *)w - s + (__builtin_ctzl(~word_orc_b(*w)) >> 3);
+#else
+    sc = (const char *)w;
+#endif
+#else
+    sc = s;
+#endif
+
+    for (; *sc != '\0'; ++sc) /* nothing */
         ;
 
     return sc - s;
@@ -545,43 +773,119 @@ RTM_EXPORT(rt_show_version);
 /* private function */
 #define isdigit(c) ((unsigned)((c) - '0') < 10)
 
+/* "00" to "99", a decimal number is converted two digits at a time */
+static const char two_digits[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 #ifdef RT_PRINTF_LONGLONG
-rt_inline int divide(long long *n, int base)
+/*
+ * divide a 64 bits number by 10000 and return the remainder. The low word is
+ * divided in 16 bits halves, so only 32 bits division by a constant is used,
+ * which is a multiplication instead of a __udivdi3 call on RV32.
+ */
+static rt_uint32_t divide_10000(rt_uint64_t *n)
 {
-    int res;
+    rt_uint32_t hi, mid, lo, r;
+
+    hi = (rt_uint32_t)(*n >> 32);
+    lo = (rt_uint32_t)(*n & 0xffffffffU);
+
+    r  = hi % 10000U;
+    hi = hi / 10000U;
+
+    mid = (r << 16) | (lo >> 16);
+    r   = mid % 10000U;
+    mid = mid / 10000U;
+
+    lo = (r << 16) | (lo & 0xffff);
+    r  = lo % 10000U;
+    lo = lo / 10000U;
+
+    *n = ((rt_uint64_t)hi << 32) | (mid << 16) | lo;
+
+    return r;
+}
+#endif
+
+/*
+ * put the digits of a number into tmp in reverse order, return the number
+ * of digits.
+ */
+static int number_digits(char *tmp, unsigned long num, int base, const char *digits)
+{
+    int i = 0;
+    unsigned long r;
 
-    /* optimized for processor which does not support divide instructions. */
     if (base == 10)
     {
-        res = (int)(((unsigned long long)*n) % 10U);
-        *n = (long long)(((unsigned long long)*n) / 10U);
+        while (num >= 100)
+        {
+            r = (num % 100) * 2;
+            num /= 100;
+            tmp[i++] = two_digits[r + 1];
+            tmp[i++] = two_digits[r];
+        }
+
+        if (num >= 10)
+        {
+            tmp[i++] = two_digits[num * 2 + 1];
+            tmp[i++] = two_digits[num * 2];
+        }
+        else
+            tmp[i++] = '0' + num;
     }
     else
     {
-        res = (int)(((unsigned long long)*n) % 16U);
-        *n = (long long)(((unsigned long long)*n) / 16U);
+        /* base 8 or 16 */
+        r = (base == 16) ? 4 : 3;
+        do
+        {
+            tmp[i++] = digits[num & (base - 1)];
+            num >>= r;
+        } while (num != 0);
     }
 
-    return res;
+    return i;
 }
-#else
-rt_inline int divide(long *n, int base)
+
+#ifdef RT_PRINTF_LONGLONG
+static int number_digits_ll(char *tmp, unsigned long long num, int base, const char *digits)
 {
-    int res;
+    int i = 0;
+    rt_uint32_t r;
 
-    /* optimized for processor which does not support divide instructions. */
     if (base == 10)
     {
-        res = (int)(((unsigned long)*n) % 10U);
-        *n = (long)(((unsigned long)*n) / 10U);
+        /* four digits a time until the number fits a long */
+        while (num > (unsigned long)-1)
+        {
+            r = divide_10000(&num);
+            tmp[i++] = two_digits[(r % 100) * 2 + 1];
+            tmp[i++] = two_digits[(r % 100) * 2];
+            tmp[i++] = two_digits[(r / 100) * 2 + 1];
+            tmp[i++] = two_digits[(r / 100) * 2];
+        }
     }
     else
     {
-        res = (int)(((unsigned long)*n) % 16U);
-        *n = (long)(((unsigned long)*n) / 16U);
+        r = (base == 16) ? 4 : 3;
+        while (num > (unsigned long)-1)
+        {
+            tmp[i++] = digits[num & (base - 1)];
+            num >>= r;
+        }
     }
 
-    return res;
+    return i + number_digits(tmp + i, (unsigned long)num, base, digits);
 }
 #endif
 
@@ -673,14 +977,11 @@ static char *print_number(char *buf,
     }
 #endif
 
-    i = 0;
-    if (num == 0)
-        tmp[i++] = '0';
-    else
-    {
-        while (num != 0)
-            tmp[i++] = digits[divide(&num, base)];
-    }
+#ifdef RT_PRINTF_LONGLONG
+    i = number_digits_ll(tmp, num, base, digits);
+#else
+    i = number_digits(tmp, num, base, digits);
+#endif
 
 #ifdef RT_PRINTF_PRECISION
     if (i > precision)
@@ -690,89 +991,785 @@ static char *print_number(char *buf,
     size -= i;
 #endif
 
-    if (!(type & (ZEROPAD | LEFT)))
+    if (!(type & (ZEROPAD | LEFT)))
+    {
+        if ((sign) && (size > 0))
+            size--;
+
+        while (size-- > 0)
+        {
+            if (buf < end)
+                *buf = ' ';
+            ++buf;
+        }
+    }
+
+    if (sign)
+    {
+        if (buf < end)
+        {
+            *buf = sign;
+        }
+        --size;
+        ++buf;
+    }
+
+#ifdef RT_PRINTF_SPECIAL
+    if (type & SPECIAL)
+    {
+        if (base == 8)
+        {
+            if (buf < end)
+                *buf = '0';
+            ++buf;
+        }
+        else if (base == 16)
+        {
+            if (buf < end)
+                *buf = '0';
+            ++buf;
+            if (buf < end)
+            {
+                *buf = type & LARGE ? 'X' : 'x';
+            }
+            ++buf;
+        }
+    }
+#endif
+
+    /* no align to the left */
+    if (!(type & LEFT))
+    {
+        while (size-- > 0)
+        {
+            if (buf < end)
+                *buf = c;
+            ++buf;
+        }
+    }
+
+#ifdef RT_PRINTF_PRECISION
+    while (i < precision--)
+    {
+        if (buf < end)
+            *buf = '0';
+        ++buf;
+    }
+#endif
+
+    /* put number in the temporary buffer */
+    while (i-- > 0 && (precision_bak != 0))
+    {
+        if (buf < end)
+            *buf = tmp[i];
+        ++buf;
+    }
+
+    while (size-- > 0)
+    {
+        if (buf < end)
+            *buf = ' ';
+        ++buf;
+    }
+
+    return buf;
+}
+
+#ifdef RT_PRINTF_FLOAT
+#define FLOAT_DIGITS    17  /* the most digits to identify a double */
+#define FLOAT_EXACT     18  /* the digits of a double kept for rounding */
+#define FLOAT_SLACK     2   /* the error of those digits, in the last one */
+
+/* a floating point number f * 2^e with 64 bits significand */
+struct float_diy
+{
+    rt_uint64_t f;
+    int e;
+};
+
+/* the normalized 10^k, k = -348, -340, ... 340 */
+static const rt_uint64_t float_cached_f[] =
+{
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+static const rt_int16_t float_cached_e[] =
+{
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066
+};
+
+static const rt_uint64_t float_pow10[] =
+{
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+    100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static struct float_diy float_normalize(struct float_diy x)
+{
+    if ((x.f >> 32) == 0)
+    {
+        x.f <<= 32;
+        x.e -= 32;
+    }
+    while (!(x.f >> 63))
+    {
+        x.f <<= 1;
+        x.e --;
+    }
+
+    return x;
+}
+
+/* the rounded high 64 bits of x * y, built on 32x32 bits multiplications */
+static struct float_diy float_multiply(struct float_diy x, struct float_diy y)
+{
+    rt_uint32_t a = (rt_uint32_t)(x.f >> 32), b = (rt_uint32_t)(x.f & 0xffffffffU);
+    rt_uint32_t c = (rt_uint32_t)(y.f >> 32), d = (rt_uint32_t)(y.f & 0xffffffffU);
+    rt_uint64_t ac = (rt_uint64_t)a * c, bc = (rt_uint64_t)b * c;
+    rt_uint64_t ad = (rt_uint64_t)a * d, bd = (rt_uint64_t)b * d;
+    rt_uint64_t mid;
+    struct float_diy r;
+
+    mid = (bd >> 32) + (ad & 0xffffffffU) + (bc & 0xffffffffU) + (1U << 31);
+    r.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+    r.e = x.e + y.e + 64;
+
+    return r;
+}
+
+/* split a double into its significand and binary exponent */
+static struct float_diy float_unpack(double value)
+{
+    union
+    {
+        double d;
+        rt_uint64_t u;
+    } bits;
+    struct float_diy v;
+
+    bits.d = value;
+    v.f = bits.u & ((1ULL << 52) - 1);
+    v.e = (int)((bits.u >> 52) & 0x7ff);
+    if (v.e != 0)
+    {
+        v.f += 1ULL << 52;
+        v.e -= 1023 + 52;
+    }
+    else
+        v.e = 1 - 1023 - 52;
+
+    return v;
+}
+
+/*
+ * get the cached power c which brings a normalized number with exponent e
+ * into [2^-60, 2^-32) after multiplied, and return its decimal exponent k,
+ * c ~ 10^-k. ceil((-61 - e) * log10(2)) is computed with log10(2) ~ 78913 / 2^18.
+ */
+static int float_cached_power(int e, struct float_diy *c)
+{
+    int index;
+
+    index = ((((((-61 - e) * 78913) + (1 << 18) - 1) >> 18) + 347) >> 3) + 1;
+    c->f = float_cached_f[index];
+    c->e = float_cached_e[index];
+
+    return -348 + (index << 3);
+}
+
+/* move the last digit towards the exact value as long as it is in range */
+static void float_grisu_round(char *digits, int len, rt_uint64_t delta, rt_uint64_t rest,
+                              rt_uint64_t ten_kappa, rt_uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+    {
+        digits[len - 1] --;
+        rest += ten_kappa;
+    }
+}
+
+/*
+ * get the shortest decimal digits in the boundaries of a positive finite
+ * value by Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly
+ * and Accurately with Integers"). The digits always convert back to the same
+ * value. Return the number of digits, and the decimal exponent of the first
+ * digit in exp.
+ *
+ * A value exactly representable by float is taken as a float promoted to
+ * double by variable arguments, and only has to convert back to the float.
+ */
+static int float_shortest(double value, char *digits, int *exp)
+{
+    struct float_diy v, w, wp, wm, c;
+    rt_uint64_t hidden, delta, p2, one_mask;
+    rt_uint32_t p1, div;
+    int k, kappa, len, shift;
+    float single = (float)value;
+
+    if ((double)single == value)
+    {
+        union
+        {
+            float f;
+            rt_uint32_t u;
+        } fbits;
+
+        fbits.f = single;
+        hidden = 1ULL << 23;
+        v.f = fbits.u & (hidden - 1);
+        v.e = (int)((fbits.u >> 23) & 0xff);
+        if (v.e != 0)
+        {
+            v.f += hidden;
+            v.e -= 127 + 23;
+        }
+        else
+            v.e = 1 - 127 - 23;
+    }
+    else
+    {
+        hidden = 1ULL << 52;
+        v = float_unpack(value);
+    }
+
+    /* the boundaries are halfway to the neighbours, the lower neighbour is
+     * closer on a power of two */
+    wp.f = (v.f << 1) + 1;
+    wp.e = v.e - 1;
+    wp = float_normalize(wp);
+    if (v.f == hidden)
+    {
+        wm.f = (v.f << 2) - 1;
+        wm.e = v.e - 2;
+    }
+    else
+    {
+        wm.f = (v.f << 1) - 1;
+        wm.e = v.e - 1;
+    }
+    wm.f <<= wm.e - wp.e;
+    wm.e = wp.e;
+
+    k = -float_cached_power(wp.e, &c);
+    w  = float_multiply(float_normalize(v), c);
+    wp = float_multiply(wp, c);
+    wm = float_multiply(wm, c);
+    wp.f --;
+    wm.f ++;
+    delta = wp.f - wm.f;
+
+    /* generate digits of wp, the integer part p1 and fraction part p2 */
+    shift = -wp.e;
+    one_mask = (1ULL << shift) - 1;
+    p1 = (rt_uint32_t)(wp.f >> shift);
+    p2 = wp.f & one_mask;
+    len = 0;
+
+    for (kappa = 1, div = 1; kappa < 10 && p1 >= div * 10; kappa ++)
+        div *= 10;
+
+    while (kappa > 0)
+    {
+        digits[len] = '0' + p1 / div;
+        p1 %= div;
+        if (digits[len] != '0' || len != 0)
+            len ++;
+        kappa --;
+        div /= 10;
+
+        if ((((rt_uint64_t)p1 << shift) + p2) <= delta)
+        {
+            k += kappa;
+            float_grisu_round(digits, len, delta, ((rt_uint64_t)p1 << shift) + p2,
+                              float_pow10[kappa] << shift, wp.f - w.f);
+            *exp = k + len - 1;
+
+            return len;
+        }
+    }
+
+    while (1)
+    {
+        p2 *= 10;
+        delta *= 10;
+        digits[len] = '0' + (char)(p2 >> shift);
+        if (digits[len] != '0' || len != 0)
+            len ++;
+        p2 &= one_mask;
+        kappa --;
+
+        if (p2 < delta)
+        {
+            k += kappa;
+            float_grisu_round(digits, len, delta, p2, 1ULL << shift,
+                              (wp.f - w.f) * float_pow10[-kappa]);
+            *exp = k + len - 1;
+
+            return len;
+        }
+    }
+}
+
+/*
+ * get FLOAT_EXACT significant digits of a positive finite value, and the
+ * decimal exponent of the first digit in exp. The value is scaled by a
+ * cached power into 64 bits, which keeps the digits exact except in the
+ * last one or two.
+ */
+static void float_digits(double value, char *digits, int *exp)
+{
+    struct float_diy w, c;
+    rt_uint64_t p2, one_mask;
+    rt_uint32_t p1, div;
+    int k, len, shift;
+
+    w = float_normalize(float_unpack(value));
+    k = -float_cached_power(w.e, &c);
+    w = float_multiply(w, c);
+
+    /* the integer part is in [8, 2^32) */
+    shift = -w.e;
+    one_mask = (1ULL << shift) - 1;
+    p1 = (rt_uint32_t)(w.f >> shift);
+    p2 = w.f & one_mask;
+
+    for (len = 1, div = 1; len < 10 && p1 >= div * 10; len ++)
+        div *= 10;
+    *exp = k + len - 1;
+
+    for (len = 0; div != 0 && len < FLOAT_EXACT; len ++)
+    {
+        digits[len] = '0' + p1 / div;
+        p1 %= div;
+        div /= 10;
+    }
+
+    for (; len < FLOAT_EXACT; len ++)
+    {
+        p2 *= 10;
+        digits[len] = '0' + (char)(p2 >> shift);
+        p2 &= one_mask;
+    }
+}
+
+/*
+ * the big integers to compare a value with a rounding boundary exactly, the
+ * largest is 2^53 * 5^340 from the smallest subnormal.
+ */
+#define FLOAT_BIG_WORDS 28
+#define FLOAT_BIG_MASK  0xffffffffUL    /* rt_uint32_t is long on a 64 bits host */
+
+struct float_big
+{
+    int len;
+    rt_uint32_t w[FLOAT_BIG_WORDS];
+};
+
+static void float_big_set(struct float_big *b, rt_uint64_t v)
+{
+    b->w[0] = (rt_uint32_t)(v & FLOAT_BIG_MASK);
+    b->w[1] = (rt_uint32_t)(v >> 32);
+    b->len = b->w[1] ? 2 : 1;
+}
+
+static void float_big_mul(struct float_big *b, rt_uint32_t k)
+{
+    rt_uint64_t carry = 0;
+    int i;
+
+    for (i = 0; i < b->len; i++)
+    {
+        carry += (rt_uint64_t)b->w[i] * k;
+        b->w[i] = (rt_uint32_t)(carry & FLOAT_BIG_MASK);
+        carry >>= 32;
+    }
+    if (carry)
+        b->w[b->len ++] = (rt_uint32_t)carry;
+}
+
+static void float_big_mul_pow5(struct float_big *b, int n)
+{
+    /* 5^13 is the largest power of 5 in 32 bits */
+    for (; n >= 13; n -= 13)
+        float_big_mul(b, 1220703125);
+    while (n-- > 0)
+        float_big_mul(b, 5);
+}
+
+static void float_big_shl(struct float_big *b, int n)
+{
+    int words = n / 32, bits = n % 32, i;
+
+    if (bits)
+    {
+        b->w[b->len] = 0;
+        for (i = b->len; i > 0; i--)
+            b->w[i] = ((b->w[i] << bits) & FLOAT_BIG_MASK) | (b->w[i - 1] >> (32 - bits));
+        b->w[0] = (b->w[0] << bits) & FLOAT_BIG_MASK;
+        if (b->w[b->len])
+            b->len ++;
+    }
+
+    if (words)
+    {
+        for (i = b->len - 1; i >= 0; i--)
+            b->w[i + words] = b->w[i];
+        for (i = 0; i < words; i++)
+            b->w[i] = 0;
+        b->len += words;
+    }
+}
+
+static int float_big_cmp(const struct float_big *a, const struct float_big *b)
+{
+    int i;
+
+    if (a->len != b->len)
+        return a->len > b->len ? 1 : -1;
+
+    for (i = a->len - 1; i >= 0; i--)
+    {
+        if (a->w[i] != b->w[i])
+            return a->w[i] > b->w[i] ? 1 : -1;
+    }
+
+    return 0;
+}
+
+/*
+ * compare the value with the boundary (d + 1/2) * 10^q exactly, that is
+ * m * 2^(e + 1) with (2d + 1) * 5^q * 2^q, and return 1, 0 or -1 if the
+ * value is above, on or below it.
+ */
+static int float_half_cmp(double value, rt_uint64_t d, int q)
+{
+    struct float_diy v = float_unpack(value);
+    struct float_big a, b;
+    int shift;
+
+    float_big_set(&a, v.f);
+    float_big_set(&b, 2 * d + 1);
+
+    if (q >= 0)
+        float_big_mul_pow5(&b, q);
+    else
+        float_big_mul_pow5(&a, -q);
+
+    shift = v.e + 1 - q;
+    if (shift >= 0)
+        float_big_shl(&a, shift);
+    else
+        float_big_shl(&b, -shift);
+
+    return float_big_cmp(&a, &b);
+}
+
+/*
+ * round the FLOAT_EXACT digits to ndigits significant digits and return the
+ * number of digits left, an exact tie is rounded to even. The exponent is increased
+ * when rounding carries out, and a value rounded to zero is "0" with
+ * exponent 0.
+ */
+static int float_round(double value, char *digits, int ndigits, int *exp)
+{
+    rt_uint64_t kept = 0, rest = 0, half = 5;
+    int i, up, cmp;
+
+    if (ndigits > FLOAT_DIGITS)
+        ndigits = FLOAT_DIGITS;
+
+    if (ndigits < 0)
+    {
+        digits[0] = '0';
+        *exp = 0;
+
+        return 1;
+    }
+
+    for (i = 0; i < ndigits; i++)
+        kept = kept * 10 + (digits[i] - '0');
+    for (i = ndigits; i < FLOAT_EXACT; i++)
+        rest = rest * 10 + (digits[i] - '0');
+    for (i = ndigits + 1; i < FLOAT_EXACT; i++)
+        half *= 10;
+
+    /*
+     * the digits dropped can not tell a value near halfway, a tie shows as
+     * 5000..01 or 4999.. in them. The value is compared with the boundary
+     * exactly then, and a tie is rounded to even.
+     */
+    if (rest + FLOAT_SLACK >= half && rest <= half + FLOAT_SLACK)
+    {
+        cmp = float_half_cmp(value, kept, *exp - ndigits + 1);
+        up = cmp > 0 || (cmp == 0 && (kept & 1));
+    }
+    else
+        up = rest > half;
+
+    if (ndigits == 0)
+    {
+        digits[0] = up ? '1' : '0';
+        if (up)
+            *exp += 1;
+        else
+            *exp = 0;
+
+        return 1;
+    }
+
+    if (up)
     {
-        if ((sign) && (size > 0))
-            size--;
+        for (i = ndigits - 1; i >= 0 && digits[i] == '9'; i--)
+            digits[i] = '0';
 
-        while (size-- > 0)
+        if (i < 0)
         {
-            if (buf < end)
-                *buf = ' ';
-            ++buf;
+            digits[0] = '1';
+            *exp += 1;
         }
+        else
+            digits[i] ++;
     }
 
-    if (sign)
+    return ndigits;
+}
+
+/*
+ * print a double in %e, %f or %g format. Without precision, the shortest
+ * digits which convert back to the value are printed.
+ */
+static char *print_float(char *buf,
+                         char *end,
+                         double value,
+                         int size,
+                         int precision,
+                         int type,
+                         char fmt)
+{
+#define PUT(ch)                 \
+    do                          \
+    {                           \
+        if (buf < end)          \
+            *buf = (ch);        \
+        ++buf;                  \
+    } while (0)
+
+    union
     {
-        if (buf < end)
-        {
-            *buf = sign;
-        }
-        --size;
-        ++buf;
+        double d;
+        rt_uint64_t u;
+    } bits;
+    char digits[FLOAT_EXACT];
+    const char *special = RT_NULL;
+    char sign = 0, style;
+    int upper, exp = 0, ndigits = 1, len, i;
+
+    upper = (fmt == 'E' || fmt == 'F' || fmt == 'G');
+    style = fmt | 0x20;
+    if (type & LEFT)
+        type &= ~ZEROPAD;
+
+    /* get sign */
+    bits.d = value;
+    if (bits.u >> 63)
+    {
+        sign = '-';
+        value = -value;
     }
+    else if (type & PLUS)
+        sign = '+';
+    else if (type & SPACE)
+        sign = ' ';
 
-#ifdef RT_PRINTF_SPECIAL
-    if (type & SPECIAL)
+    if (((bits.u >> 52) & 0x7ff) == 0x7ff)
     {
-        if (base == 8)
+        if (bits.u & 0xfffffffffffffULL)
+            special = upper ? "NAN" : "nan";
+        else
+            special = upper ? "INF" : "inf";
+        type &= ~ZEROPAD;
+        len = 3;
+    }
+    else
+    {
+        if (value == 0)
+            rt_memset(digits, '0', FLOAT_EXACT);
+        else if (precision >= 0)
+            float_digits(value, digits, &exp);
+
+        if (precision < 0)
         {
-            if (buf < end)
-                *buf = '0';
-            ++buf;
+            if (value != 0)
+            {
+                ndigits = float_shortest(value, digits, &exp);
+                for (i = ndigits; i < FLOAT_EXACT; i++)
+                    digits[i] = '0';
+            }
+
+            if (style == 'g' && (type & SPECIAL))
+            {
+                /* '#' keeps the trailing zeros up to the default 6 digits */
+                precision = ndigits > 6 ? ndigits : 6;
+                style = (exp < -4 || exp >= precision) ? 'e' : 'f';
+                precision = (style == 'e') ? precision - 1 : precision - 1 - exp;
+            }
+            else
+            {
+                if (style == 'g')
+                    style = (exp < -4 || exp >= FLOAT_DIGITS) ? 'e' : 'f';
+                if (style == 'e')
+                    precision = ndigits - 1;
+                else
+                    precision = (ndigits - 1 - exp > 0) ? ndigits - 1 - exp : 0;
+            }
         }
-        else if (base == 16)
+        else if (style == 'e')
+            ndigits = float_round(value, digits, precision + 1, &exp);
+        else if (style == 'f')
+            ndigits = float_round(value, digits, exp + 1 + precision, &exp);
+        else
         {
-            if (buf < end)
-                *buf = '0';
-            ++buf;
-            if (buf < end)
+            if (precision == 0)
+                precision = 1;
+            ndigits = float_round(value, digits, precision, &exp);
+
+            /* remove the trailing zeros unless '#' */
+            if (!(type & SPECIAL))
             {
-                *buf = type & LARGE ? 'X' : 'x';
+                while (ndigits > 1 && digits[ndigits - 1] == '0')
+                    ndigits --;
+            }
+
+            if (exp < -4 || exp >= precision)
+            {
+                style = 'e';
+                precision = (type & SPECIAL) ? precision - 1 : ndigits - 1;
+            }
+            else
+            {
+                style = 'f';
+                if (type & SPECIAL)
+                    precision = precision - 1 - exp;
+                else
+                    precision = (ndigits - 1 - exp > 0) ? ndigits - 1 - exp : 0;
             }
-            ++buf;
         }
+
+        if (style == 'f')
+            len = (exp >= 0) ? exp + 1 : 1;
+        else
+            len = (exp >= 100 || exp <= -100) ? 6 : 5;
+        if (precision > 0 || (type & SPECIAL))
+            len += precision + 1;
     }
-#endif
 
-    /* no align to the left */
-    if (!(type & LEFT))
+    if (sign)
+        len ++;
+    size -= len;
+
+    if (!(type & (ZEROPAD | LEFT)))
     {
         while (size-- > 0)
-        {
-            if (buf < end)
-                *buf = c;
-            ++buf;
-        }
+            PUT(' ');
     }
 
-#ifdef RT_PRINTF_PRECISION
-    while (i < precision--)
+    if (sign)
+        PUT(sign);
+
+    if (type & ZEROPAD)
     {
-        if (buf < end)
-            *buf = '0';
-        ++buf;
+        while (size-- > 0)
+            PUT('0');
     }
-#endif
 
-    /* put number in the temporary buffer */
-    while (i-- > 0 && (precision_bak != 0))
+    if (special != RT_NULL)
     {
-        if (buf < end)
-            *buf = tmp[i];
-        ++buf;
+        for (i = 0; i < 3; i++)
+            PUT(special[i]);
     }
-
-    while (size-- > 0)
+    else if (style == 'f')
     {
-        if (buf < end)
-            *buf = ' ';
-        ++buf;
+        /* digits[i] is the digit of 10^(exp - i) */
+        if (exp < 0)
+            PUT('0');
+        for (i = 0; i <= exp; i++)
+            PUT(i < ndigits ? digits[i] : '0');
+
+        if (precision > 0 || (type & SPECIAL))
+            PUT('.');
+        for (i = exp + 1; i <= exp + precision; i++)
+            PUT((i >= 0 && i < ndigits) ? digits[i] : '0');
+    }
+    else
+    {
+        PUT(digits[0]);
+        if (precision > 0 || (type & SPECIAL))
+            PUT('.');
+        for (i = 1; i <= precision; i++)
+            PUT(i < ndigits ? digits[i] : '0');
+
+        PUT(upper ? 'E' : 'e');
+        if (exp < 0)
+        {
+            PUT('-');
+            exp = -exp;
+        }
+        else
+            PUT('+');
+        if (exp >= 100)
+        {
+            PUT('0' + exp / 100);
+            exp %= 100;
+        }
+        PUT(two_digits[exp * 2]);
+        PUT(two_digits[exp * 2 + 1]);
     }
 
+    while (size-- > 0)
+        PUT(' ');
+
     return buf;
+#undef PUT
 }
+#endif /* RT_PRINTF_FLOAT */
 
 rt_int32_t rt_vsnprintf(char *buf,
                         rt_size_t size,
@@ -999,6 +1996,23 @@ rt_int32_t rt_vsnprintf(char *buf,
         case 'u':
             break;
 
+#ifdef RT_PRINTF_FLOAT
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+#ifdef RT_PRINTF_PRECISION
+            str = print_float(str, end, va_arg(args, double),
+                              field_width, precision, flags, *fmt);
+#else
+            str = print_float(str, end, va_arg(args, double),
+                              field_width, -1, flags, *fmt);
+#endif
+            continue;
+#endif
+
         default:
             if (str < end)
                 *str = '%';
@@ -1174,16 +2188,9 @@ RT_WEAK void rt_hw_console_output(const char *str)
 }
 RTM_EXPORT(rt_hw_console_output);
 
-/**
- * This function will put string to the console.
- *
- * @param str the string output to the console.
- */
-void rt_kputs(const char *str)
+/* write a string of length bytes to console */
+static void _kprintf_output(const char *str, rt_size_t length)
 {
-    if (!str)
-        return;
-
 #ifdef RT_USING_DEVICE
     if (_console_device == RT_NULL)
     {
@@ -1194,7 +2201,7 @@ void rt_kputs(const char *str)
         rt_uint16_t old_flag = _console_device->open_flag;
 
         _console_device->open_flag |= RT_DEVICE_FLAG_STREAM;
-        rt_device_write(_console_device, 0, str, rt_strlen(str));
+        rt_device_write(_console_device, 0, str, length);
         _console_device->open_flag = old_flag;
     }
 #else
@@ -1202,6 +2209,281 @@ void rt_kputs(const char *str)
 #endif
 }
 
+#ifdef RT_USING_KPRINTF_ASYNC
+/*
+ * Asynchronous rt_kprintf.
+ *
+ * Once the log thread runs, rt_kprintf formats into its own record of a
+ * ring and returns without waiting for console. The log thread, at a low
+ * priority, prints the records in order with the tick they were made at.
+ *
+ * A record is reserved by moving the head counter, then formatted and
+ * committed by setting its length, so that rt_kprintf is reentrant and can
+ * be called from interrupt. When the ring is full the output is dropped
+ * and counted. Before the log thread runs, rt_kprintf prints directly.
+ *
+ * A bulk dump, which prints more than the ring holds faster than the log
+ * thread drains it, switches rt_kprintf to direct output by
+ * rt_kprintf_sync() for its duration.
+ */
+#if !defined(RT_USING_COMPONENTS_INIT) || !defined(RT_USING_SEMAPHORE)
+#error "RT_USING_KPRINTF_ASYNC requires RT_USING_COMPONENTS_INIT and RT_USING_SEMAPHORE"
+#endif
+
+#ifndef RT_KPRINTF_ASYNC_RECORDS
+#define RT_KPRINTF_ASYNC_RECORDS        16
+#endif
+#if RT_KPRINTF_ASYNC_RECORDS & (RT_KPRINTF_ASYNC_RECORDS - 1)
+#error "RT_KPRINTF_ASYNC_RECORDS must be a power of 2"
+#endif
+
+#ifndef RT_KPRINTF_ASYNC_PRIORITY
+#define RT_KPRINTF_ASYNC_PRIORITY       (RT_THREAD_PRIORITY_MAX - 2)
+#endif
+
+#ifndef RT_KPRINTF_ASYNC_STACK_SIZE
+#define RT_KPRINTF_ASYNC_STACK_SIZE     512
+#endif
+
+/* the timestamp of record, a BSP may use a cycle counter instead */
+#ifndef RT_KPRINTF_ASYNC_TIMESTAMP
+#define RT_KPRINTF_ASYNC_TIMESTAMP()    rt_tick_get()
+#endif
+
+struct kprintf_record
+{
+    volatile rt_ubase_t committed;
+    rt_uint32_t timestamp;
+    rt_uint16_t length;
+    char buf[RT_CONSOLEBUF_SIZE];
+};
+
+static struct kprintf_record _kprintf_ring[RT_KPRINTF_ASYNC_RECORDS];
+static volatile rt_ubase_t _kprintf_head;   /* the next record to reserve */
+static volatile rt_ubase_t _kprintf_tail;   /* the next record to print */
+static volatile rt_uint32_t _kprintf_dropped;
+static volatile rt_bool_t _kprintf_async;
+static rt_bool_t _kprintf_started;          /* the log thread runs */
+static rt_uint16_t _kprintf_sync_nest;
+
+/* reserve a record for the caller, RT_NULL if the ring is full */
+static struct kprintf_record *_kprintf_reserve(void)
+{
+    rt_ubase_t head;
+#if defined(__riscv_atomic)
+    head = _kprintf_head;
+    do
+    {
+        if (head - _kprintf_tail >= RT_KPRINTF_ASYNC_RECORDS)
+        {
+            __atomic_fetch_add(&_kprintf_dropped, 1, __ATOMIC_RELAXED);
+
+            return RT_NULL;
+        }
+    } while (!__atomic_compare_exchange_n(&_kprintf_head, &head, head + 1, 0,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+#else
+    /* no A extension: the reservation is a few instructions with interrupt
+     * disabled, the formatting is still done with interrupt enabled */
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    head = _kprintf_head;
+    if (head - _kprintf_tail >= RT_KPRINTF_ASYNC_RECORDS)
+    {
+        _kprintf_dropped ++;
+        rt_hw_interrupt_enable(level);
+
+        return RT_NULL;
+    }
+    _kprintf_head = head + 1;
+    rt_hw_interrupt_enable(level);
+#endif
+
+    return &_kprintf_ring[head & (RT_KPRINTF_ASYNC_RECORDS - 1)];
+}
+
+RT_SEM_DEFINE(_kprintf_sem, "klog", 0, RT_IPC_FLAG_FIFO);
+
+/* publish a formatted record, and wake up the log thread if it waits for it */
+static void _kprintf_commit(struct kprintf_record *record, rt_size_t length)
+{
+    record->timestamp = RT_KPRINTF_ASYNC_TIMESTAMP();
+    record->length = length;
+    __atomic_store_n(&record->committed, 1, __ATOMIC_RELEASE);
+
+    if (record == &_kprintf_ring[_kprintf_tail & (RT_KPRINTF_ASYNC_RECORDS - 1)])
+        rt_sem_release(&_kprintf_sem);
+}
+
+/* print the committed records in order */
+static void _kprintf_drain(void)
+{
+    struct kprintf_record *record;
+    rt_uint32_t dropped;
+    static rt_uint32_t reported;
+    static rt_bool_t line_start = RT_TRUE;
+    char prefix[32];
+
+    while (_kprintf_tail != _kprintf_head)
+    {
+        record = &_kprintf_ring[_kprintf_tail & (RT_KPRINTF_ASYNC_RECORDS - 1)];
+        if (!__atomic_load_n(&record->committed, __ATOMIC_ACQUIRE))
+        {
+            /* the record is still being formatted */
+            break;
+        }
+
+        if (record->length != 0)
+        {
+            /* the timestamp on the first record of a line */
+            if (line_start)
+            {
+                dropped = _kprintf_dropped;
+                if (dropped != reported)
+                {
+                    _kprintf_output(prefix, rt_snprintf(prefix, sizeof(prefix),
+                                    "[%d records dropped]\n", dropped - reported));
+                    reported = dropped;
+                }
+
+                _kprintf_output(prefix, rt_snprintf(prefix, sizeof(prefix),
+                                "[%8d] ", record->timestamp));
+            }
+            line_start = (record->buf[record->length - 1] == '\n');
+
+            _kprintf_output(record->buf, record->length);
+        }
+
+        record->committed = 0;
+        __atomic_store_n(&_kprintf_tail, _kprintf_tail + 1, __ATOMIC_RELEASE);
+    }
+}
+
+static void _kprintf_thread_entry(void *parameter)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    _kprintf_started = RT_TRUE;
+    if (_kprintf_sync_nest == 0)
+        _kprintf_async = RT_TRUE;
+    rt_hw_interrupt_enable(level);
+
+    while (1)
+    {
+        _kprintf_drain();
+
+        /* the timeout covers a wakeup lost in a race with the drain loop */
+        rt_sem_take(&_kprintf_sem, RT_TICK_PER_SECOND / 10 + 1);
+    }
+}
+RT_THREAD_DEFINE(_kprintf_thread, "klog", _kprintf_thread_entry, RT_NULL,
+                 RT_KPRINTF_ASYNC_STACK_SIZE, RT_KPRINTF_ASYNC_PRIORITY, 10);
+
+/**
+ * This function will print the records in asynchronous rt_kprintf ring in
+ * the caller's context, and make later rt_kprintf print directly. It is
+ * used on fatal errors, when the log thread may never run again.
+ */
+void rt_kprintf_flush(void)
+{
+    _kprintf_started = RT_FALSE;
+    _kprintf_async = RT_FALSE;
+    _kprintf_drain();
+}
+RTM_EXPORT(rt_kprintf_flush);
+
+/**
+ * This function will switch rt_kprintf to direct output, or back to the
+ * asynchronous ring. The calls nest, rt_kprintf prints directly until each
+ * switch to direct output is paired with a switch back.
+ *
+ * When it switches to direct output, it waits for the log thread to print
+ * the records in ring, so that the output stays in order.
+ *
+ * @param sync RT_TRUE for direct output, RT_FALSE to switch back
+ *
+ * @note it must be invoked in thread context.
+ */
+void rt_kprintf_sync(rt_bool_t sync)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (sync)
+    {
+        _kprintf_sync_nest ++;
+        _kprintf_async = RT_FALSE;
+    }
+    else
+    {
+        RT_ASSERT(_kprintf_sync_nest > 0);
+
+        if (-- _kprintf_sync_nest == 0 && _kprintf_started)
+            _kprintf_async = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    /* the log thread prints the records made before */
+    while (sync && _kprintf_started && _kprintf_tail != _kprintf_head)
+    {
+        rt_sem_release(&_kprintf_sem);
+        rt_thread_delay(1);
+    }
+}
+RTM_EXPORT(rt_kprintf_sync);
+
+/**
+ * This function will return the number of rt_kprintf outputs dropped
+ * because the asynchronous ring was full.
+ *
+ * @return the number of dropped outputs
+ */
+rt_uint32_t rt_kprintf_dropped(void)
+{
+    return _kprintf_dropped;
+}
+RTM_EXPORT(rt_kprintf_dropped);
+#endif /* RT_USING_KPRINTF_ASYNC */
+
+/**
+ * This function will put string to the console.
+ *
+ * @param str the string output to the console.
+ */
+void rt_kputs(const char *str)
+{
+    if (!str)
+        return;
+
+#ifdef RT_USING_KPRINTF_ASYNC
+    if (_kprintf_async)
+    {
+        struct kprintf_record *record;
+        rt_size_t length;
+
+        length = rt_strlen(str);
+        if (length == 0)
+            return;
+
+        record = _kprintf_reserve();
+        if (record != RT_NULL)
+        {
+            if (length > RT_CONSOLEBUF_SIZE - 1)
+                length = RT_CONSOLEBUF_SIZE - 1;
+            rt_memcpy(record->buf, str, length);
+            record->buf[length] = '\0';
+            _kprintf_commit(record, length);
+        }
+
+        return;
+    }
+#endif
+
+    _kprintf_output(str, rt_strlen(str));
+}
+
 /**
  * This function will print a formatted string on system console
  *
@@ -1214,6 +2496,25 @@ void rt_kprintf(const char *fmt, ...)
     static char rt_log_buf[RT_CONSOLEBUF_SIZE];
 
     va_start(args, fmt);
+#ifdef RT_USING_KPRINTF_ASYNC
+    if (_kprintf_async)
+    {
+        struct kprintf_record *record;
+
+        record = _kprintf_reserve();
+        if (record != RT_NULL)
+        {
+            length = rt_vsnprintf(record->buf, sizeof(record->buf) - 1, fmt, args);
+            if (length > RT_CONSOLEBUF_SIZE - 1)
+                length = RT_CONSOLEBUF_SIZE - 1;
+            _kprintf_commit(record, length);
+        }
+        va_end(args);
+
+        return;
+    }
+#endif
+
     /* the return value of vsnprintf is the number of bytes that would be
      * written to buffer had if the size of the buffer been sufficiently
      * large excluding the terminating null byte. If the output string
@@ -1222,24 +2523,7 @@ void rt_kprintf(const char *fmt, ...)
     length = rt_vsnprintf(rt_log_buf, sizeof(rt_log_buf) - 1, fmt, args);
     if (length > RT_CONSOLEBUF_SIZE - 1)
         length = RT_CONSOLEBUF_SIZE - 1;
-        // printfNexys(rt_log_buf);
-#ifdef RT_USING_DEVICE
-    if (_console_device == RT_NULL)
-    {
-        rt_hw_console_output(rt_log_buf);
-        // printfNexys(rt_log_buf);
-    }
-    else
-    {
-        rt_uint16_t old_flag = _console_device->open_flag;
-
-        _console_device->open_flag |= RT_DEVICE_FLAG_STREAM;
-        rt_device_write(_console_device, 0, rt_log_buf, length);
-        _console_device->open_flag = old_flag;
-    }
-#else
-    rt_hw_console_output(rt_log_buf);
-#endif
+    _kprintf_output(rt_log_buf, length);
     va_end(args);
 }
 RTM_EXPORT(rt_kprintf);
@@ -1390,6 +2674,9 @@ void rt_assert_handler(const char *ex_string, const char *func, rt_size_t line)
 #endif
         {
             rt_kprintf("(%s) assertion failed at function:%s, line number:%d \n", ex_string, func, line);
+#ifdef RT_USING_KPRINTF_ASYNC
+            rt_kprintf_flush();
+#endif
             while (dummy == 0)
                 ;
         }
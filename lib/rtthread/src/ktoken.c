@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * Tokenized logging.
+ *
+ * rt_ktoken_printf() places its format string, with the types of arguments
+ * known at compile time, in the rt_ktoken section of the ELF file. It sends
+ * the offset of the entry in that section (the token) with the raw
+ * arguments instead of formatting them, so nothing is parsed on target.
+ *
+ * A record is
+ *
+ *     varint(token) argument...
+ *
+ * An integer is a zigzag varint, a 64 bits integer a zigzag varint of 64
+ * bits, a float 4 bytes and a double 8 bytes in little endian, and a string
+ * a varint length followed by its bytes.
+ *
+ * The record is printed on console in base64 after a '$' and ended by a new
+ * line, so it passes through the string console and the asynchronous
+ * rt_kprintf ring like any other line. tools/ktoken decodes the console
+ * output with the ELF file.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_KTOKEN
+
+#ifndef RT_KTOKEN_BUF_SIZE
+#define RT_KTOKEN_BUF_SIZE          48
+#endif
+
+/* the longest string argument kept in a record */
+#define KTOKEN_STRING_MAX           32
+
+/* the start of formats, defined by linker for the section */
+extern const struct rt_ktoken __start_rt_ktoken[];
+
+static const char base64_table[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static rt_uint8_t *ktoken_varint(rt_uint8_t *buf, rt_uint8_t *end, rt_uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        if (buf == end)
+            return RT_NULL;
+        *buf++ = (rt_uint8_t)value | 0x80;
+        value >>= 7;
+    }
+
+    if (buf == end)
+        return RT_NULL;
+    *buf++ = (rt_uint8_t)value;
+
+    return buf;
+}
+
+static rt_uint8_t *ktoken_varint64(rt_uint8_t *buf, rt_uint8_t *end, rt_uint64_t value)
+{
+    /* 32 bits arithmetic once the value fits */
+    while (value >> 32)
+    {
+        if (buf == end)
+            return RT_NULL;
+        *buf++ = (rt_uint8_t)value | 0x80;
+        value >>= 7;
+    }
+
+    return ktoken_varint(buf, end, (rt_uint32_t)value);
+}
+
+/**
+ * @addtogroup KernelService
+ */
+
+/**@{*/
+
+/**
+ * This function will encode a tokenized log record into a buffer.
+ *
+ * @param buf the buffer to hold record
+ * @param size the size of buffer
+ * @param token the format in rt_ktoken section
+ * @param args the arguments
+ *
+ * @return the size of record. The arguments which do not fit the buffer
+ *         are left out.
+ */
+rt_size_t rt_ktoken_vencode(rt_uint8_t *buf,
+                            rt_size_t size,
+                            const struct rt_ktoken *token,
+                            va_list args)
+{
+    rt_uint8_t *ptr, *next, *end = buf + size;
+    rt_uint32_t types, count, length;
+    unsigned int value;
+    rt_int64_t value64;
+    const char *str;
+    union
+    {
+        double d;
+        rt_uint64_t u;
+    } bits;
+    union
+    {
+        float f;
+        rt_uint32_t u;
+    } fbits;
+
+    ptr = ktoken_varint(buf, end, (rt_uint32_t)((const char *)token - (const char *)__start_rt_ktoken) / 4);
+    if (ptr == RT_NULL)
+        return 0;
+
+    types = token->types;
+    for (count = types & RT_KTOKEN_COUNT_MASK, types >>= 4; count > 0; count--, types >>= 3)
+    {
+        switch (types & 0x07)
+        {
+        case RT_KTOKEN_INT64:
+            value64 = va_arg(args, rt_int64_t);
+            next = ktoken_varint64(ptr, end, ((rt_uint64_t)value64 << 1) ^ (rt_uint64_t)(value64 >> 63));
+            break;
+
+        case RT_KTOKEN_FLOAT:
+            /* a float is promoted to double by variable arguments */
+            fbits.f = (float)va_arg(args, double);
+            next = RT_NULL;
+            if (end - ptr >= 4)
+            {
+                for (length = 0; length < 4; length++)
+                    ptr[length] = (rt_uint8_t)(fbits.u >> (length * 8));
+                next = ptr + 4;
+            }
+            break;
+
+        case RT_KTOKEN_DOUBLE:
+            bits.d = va_arg(args, double);
+            next = RT_NULL;
+            if (end - ptr >= 8)
+            {
+                for (length = 0; length < 8; length++)
+                    ptr[length] = (rt_uint8_t)(bits.u >> (length * 8));
+                next = ptr + 8;
+            }
+            break;
+
+        case RT_KTOKEN_STRING:
+            str = va_arg(args, const char *);
+            if (str == RT_NULL)
+                str = "(null)";
+            length = rt_strlen(str);
+            if (length > KTOKEN_STRING_MAX)
+                length = KTOKEN_STRING_MAX;
+            next = ktoken_varint(ptr, end, length);
+            if (next != RT_NULL && (rt_uint32_t)(end - next) >= length)
+            {
+                rt_memcpy(next, str, length);
+                next += length;
+            }
+            else
+                next = RT_NULL;
+            break;
+
+        default:
+            /* int, long and pointer are all 32 bits on target */
+            value = (unsigned int)va_arg(args, int);
+            next = ktoken_varint(ptr, end, (value << 1) ^ (0U - (value >> 31)));
+            break;
+        }
+
+        /* the record is full */
+        if (next == RT_NULL)
+            break;
+        ptr = next;
+    }
+
+    return ptr - buf;
+}
+RTM_EXPORT(rt_ktoken_vencode);
+
+/**
+ * This function will encode a tokenized log record into a buffer.
+ *
+ * @param buf the buffer to hold record
+ * @param size the size of buffer
+ * @param token the format in rt_ktoken section, see RT_KTOKEN
+ *
+ * @return the size of record
+ */
+rt_size_t rt_ktoken_encode(rt_uint8_t *buf, rt_size_t size, const struct rt_ktoken *token, ...)
+{
+    va_list args;
+    rt_size_t length;
+
+    va_start(args, token);
+    length = rt_ktoken_vencode(buf, size, token, args);
+    va_end(args);
+
+    return length;
+}
+RTM_EXPORT(rt_ktoken_encode);
+
+/**
+ * This function will print a tokenized log record on console. It is called
+ * by rt_ktoken_printf.
+ *
+ * @param token the format in rt_ktoken section
+ */
+void rt_ktoken_print(const struct rt_ktoken *token, ...)
+{
+    va_list args;
+    rt_uint8_t record[RT_KTOKEN_BUF_SIZE];
+    char line[1 + (RT_KTOKEN_BUF_SIZE + 2) / 3 * 4 + 2];
+    rt_size_t length, index;
+    rt_uint32_t triple;
+    char *ptr = line;
+
+    va_start(args, token);
+    length = rt_ktoken_vencode(record, sizeof(record), token, args);
+    va_end(args);
+
+    *ptr++ = '$';
+    for (index = 0; index + 3 <= length; index += 3)
+    {
+        triple = (record[index] << 16) | (record[index + 1] << 8) | record[index + 2];
+        *ptr++ = base64_table[(triple >> 18) & 0x3f];
+        *ptr++ = base64_table[(triple >> 12) & 0x3f];
+        *ptr++ = base64_table[(triple >> 6) & 0x3f];
+        *ptr++ = base64_table[triple & 0x3f];
+    }
+
+    /* the last one or two bytes, without padding */
+    if (index < length)
+    {
+        triple = record[index] << 16;
+        if (index + 1 < length)
+            triple |= record[index + 1] << 8;
+        *ptr++ = base64_table[(triple >> 18) & 0x3f];
+        *ptr++ = base64_table[(triple >> 12) & 0x3f];
+        if (index + 1 < length)
+            *ptr++ = base64_table[(triple >> 6) & 0x3f];
+    }
+    *ptr++ = '\n';
+    *ptr = '\0';
+
+    rt_kputs(line);
+}
+RTM_EXPORT(rt_ktoken_print);
+
+/**@}*/
+
+#endif /* end of RT_USING_KTOKEN */
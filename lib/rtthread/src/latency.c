@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * Scheduler and interrupt latency histograms.
+ *
+ * A thread is stamped with the cycle counter when it becomes ready, that is
+ * when it is inserted to the ready queue, or when it is switched out while
+ * still ready. When the scheduler switches to the thread, the cycles since
+ * the stamp are its wakeup-to-run latency, recorded in the histogram of
+ * thread and in the global one.
+ *
+ * The BSP records the interrupt entry latency by rt_latency_irq(), with the
+ * cycle count at which the interrupt was raised.
+ *
+ * A histogram has RT_LATENCY_BUCKETS log2 buckets: bucket i counts samples
+ * from 2^i to 2^(i+1) - 1 cycles, bucket 0 also counts 0, and the last one
+ * counts all longer samples. The maximum is kept apart.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_LATENCY
+
+static struct rt_latency_hist _latency_wakeup;
+static struct rt_latency_hist _latency_irq;
+
+/* it must be invoked with interrupt disabled */
+static void _rt_latency_hist_add(struct rt_latency_hist *hist, rt_uint32_t cycles)
+{
+    int index;
+
+    index = cycles > 1 ? 31 - __builtin_clz(cycles) : 0;
+    if (index > RT_LATENCY_BUCKETS - 1)
+        index = RT_LATENCY_BUCKETS - 1;
+
+    hist->count[index] ++;
+    if (cycles > hist->max)
+        hist->max = cycles;
+}
+
+/**
+ * @addtogroup Thread
+ */
+
+/**@{*/
+
+/**
+ * This function will stamp a thread becoming ready. It is invoked by
+ * rt_schedule_insert_thread with interrupt disabled.
+ *
+ * @param thread the thread inserted to ready queue
+ *
+ * @note Please do not invoke this function in user application.
+ */
+void rt_latency_ready(struct rt_thread *thread)
+{
+    thread->ready_cycle = rt_hw_cycle_get();
+}
+
+/**
+ * This function will record the wakeup-to-run latency of the thread switched
+ * to. It is invoked by the scheduler with interrupt disabled.
+ *
+ * @param from the thread switched out
+ * @param to the thread switched to
+ *
+ * @note Please do not invoke this function in user application.
+ */
+void rt_latency_switch(struct rt_thread *from, struct rt_thread *to)
+{
+    rt_uint32_t now, cycles;
+
+    now = rt_hw_cycle_get();
+
+    /* the preempted thread waits in ready queue from now on */
+    if ((from->stat & RT_THREAD_STAT_MASK) == RT_THREAD_READY)
+        from->ready_cycle = now;
+
+    cycles = now - to->ready_cycle;
+    _rt_latency_hist_add(&_latency_wakeup, cycles);
+    _rt_latency_hist_add(&to->latency, cycles);
+}
+
+/**
+ * This function will record the entry latency of an interrupt. It is invoked
+ * by the interrupt service routine of BSP.
+ *
+ * @param raised the cycle count at which the interrupt was raised
+ */
+void rt_latency_irq(rt_uint32_t raised)
+{
+    register rt_base_t level;
+    rt_uint32_t cycles;
+
+    cycles = rt_hw_cycle_get() - raised;
+
+    level = rt_hw_interrupt_disable();
+    _rt_latency_hist_add(&_latency_irq, cycles);
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_latency_irq);
+
+/**
+ * This function will get a copy of the wakeup-to-run latency histogram.
+ *
+ * @param thread the thread, or RT_NULL for the histogram of all threads
+ * @param hist the histogram copied to
+ */
+void rt_latency_wakeup_get(rt_thread_t thread, struct rt_latency_hist *hist)
+{
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    *hist = thread != RT_NULL ? thread->latency : _latency_wakeup;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_latency_wakeup_get);
+
+/**
+ * This function will get a copy of the interrupt entry latency histogram.
+ *
+ * @param hist the histogram copied to
+ */
+void rt_latency_irq_get(struct rt_latency_hist *hist)
+{
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    *hist = _latency_irq;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_latency_irq_get);
+
+/**
+ * This function will clear all the latency histograms.
+ */
+void rt_latency_reset(void)
+{
+    struct rt_list_node *node;
+    struct rt_object_information *information;
+    struct rt_thread *thread;
+    register rt_base_t level;
+
+    information = rt_object_get_information(RT_Object_Class_Thread);
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(&_latency_wakeup, 0, sizeof(_latency_wakeup));
+    rt_memset(&_latency_irq, 0, sizeof(_latency_irq));
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        thread = (struct rt_thread *)rt_list_entry(node, struct rt_object, list);
+        rt_memset(&thread->latency, 0, sizeof(thread->latency));
+    }
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_latency_reset);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static rt_uint32_t latency_samples(struct rt_latency_hist *hist)
+{
+    rt_uint32_t samples = 0;
+    int index;
+
+    for (index = 0; index < RT_LATENCY_BUCKETS; index++)
+        samples += hist->count[index];
+
+    return samples;
+}
+
+/* the upper bound of the bucket where 99% of samples are reached */
+static rt_uint32_t latency_p99(struct rt_latency_hist *hist, rt_uint32_t samples)
+{
+    rt_uint32_t sum = 0;
+    int index;
+
+    for (index = 0; index < RT_LATENCY_BUCKETS - 1; index++)
+    {
+        sum += hist->count[index];
+        if (sum * 100 >= samples * 99)
+            break;
+    }
+
+    return index < RT_LATENCY_BUCKETS - 1 ? (2UL << index) - 1 : hist->max;
+}
+
+static void latency_show(const char *title, struct rt_latency_hist *hist)
+{
+    int index;
+
+    rt_kprintf("%s: %d samples, max %d cycles\n", title, latency_samples(hist), hist->max);
+    for (index = 0; index < RT_LATENCY_BUCKETS; index++)
+    {
+        if (hist->count[index] == 0)
+            continue;
+
+        if (index < RT_LATENCY_BUCKETS - 1)
+            rt_kprintf("  < %8d %8d\n", 2UL << index, hist->count[index]);
+        else
+            rt_kprintf("  >= %7d %8d\n", 1UL << index, hist->count[index]);
+    }
+}
+
+static void latency_dump(void)
+{
+    struct rt_list_node *node;
+    struct rt_object_information *information;
+    struct rt_thread *thread;
+    struct rt_latency_hist hist;
+    rt_uint32_t samples;
+
+    rt_latency_wakeup_get(RT_NULL, &hist);
+    latency_show("wakeup to run", &hist);
+    rt_latency_irq_get(&hist);
+    latency_show("interrupt entry", &hist);
+
+    rt_kprintf("\n%-*.s  samples  max cyc  p99 cyc\n", RT_NAME_MAX, "thread");
+    rt_kprintf("%-*.s -------- -------- --------\n", RT_NAME_MAX, "--------");
+
+    information = rt_object_get_information(RT_Object_Class_Thread);
+    rt_enter_critical();
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        thread = (struct rt_thread *)rt_list_entry(node, struct rt_object, list);
+        rt_latency_wakeup_get(thread, &hist);
+
+        samples = latency_samples(&hist);
+        rt_kprintf("%-*.*s %8d %8d %8d\n", RT_NAME_MAX, RT_NAME_MAX, thread->name,
+                   samples, hist.max, samples ? latency_p99(&hist, samples) : 0);
+    }
+    rt_exit_critical();
+}
+
+int latency(int argc, char **argv)
+{
+    if (argc == 1)
+    {
+        latency_dump();
+        return 0;
+    }
+
+    if (argc == 2 && !rt_strcmp(argv[1], "reset"))
+    {
+        rt_latency_reset();
+        return 0;
+    }
+
+    rt_kprintf("usage: latency [reset]\n");
+
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(latency, show latency histograms in cycles: [reset]);
+#endif /* end of RT_USING_FINSH */
+
+#endif /* end of RT_USING_LATENCY */
@@ -11,6 +11,9 @@
  * 2010-07-13     Bernard      fix RT_ALIGN issue found by kuronca
  * 2010-10-14     Bernard      fix rt_realloc issue when realloc a NULL pointer.
  * 2017-07-14     armink       fix rt_realloc issue when new size is 0
+ * 2026-10-19     tangmenglin  add memory pressure check and reclaim retry
+ * 2026-10-19     tangmenglin  account heap usage per thread in memtrace
+ * 2026-10-19     tangmenglin  bound the reclaim retries
  */
 
 /*
@@ -101,7 +104,8 @@ struct heap_mem
     rt_size_t next, prev;
 
 #ifdef RT_USING_MEMTRACE
-    rt_uint8_t thread[4];   /* thread name */
+    rt_uint8_t slot;        /* heap accounting slot of owner thread */
+    rt_uint8_t reserved[3];
 #endif
 };
 
@@ -124,20 +128,108 @@ static rt_size_t mem_size_aligned;
 static rt_size_t used_mem, max_mem;
 #endif
 #ifdef RT_USING_MEMTRACE
-rt_inline void rt_mem_setname(struct heap_mem *mem, const char *name)
+#ifndef RT_MEMTRACE_SLOT_MAX
+#define RT_MEMTRACE_SLOT_MAX    16
+#endif
+#define MEMTRACE_SLOT_MISC      0
+
+/*
+ * heap usage of threads. The slot of a thread is cached in thread->mem_slot
+ * and in the header of each block it allocates, so the accounting is O(1)
+ * on both allocation and release. The slot 0 collects the blocks allocated
+ * without thread context or when the slot table is full. A slot is kept
+ * after its owner exits until all of its blocks are released.
+ */
+static struct rt_mem_thread_stat memtrace_slot[RT_MEMTRACE_SLOT_MAX];
+
+static rt_bool_t memtrace_slot_alive(rt_uint8_t index)
+{
+    rt_thread_t thread = memtrace_slot[index].thread;
+
+    if (thread == RT_NULL)
+        return RT_FALSE;
+
+    /* the thread object may be detached or re-initialized by another thread */
+    if (rt_object_get_type((rt_object_t)thread) != RT_Object_Class_Thread ||
+        thread->mem_slot != index ||
+        (thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_CLOSE)
+    {
+        memtrace_slot[index].thread = RT_NULL;
+
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
+static rt_uint8_t memtrace_slot_get(rt_thread_t thread)
 {
-    int index;
-    for (index = 0; index < sizeof(mem->thread); index ++)
+    rt_uint8_t index;
+    struct rt_mem_thread_stat *stat;
+
+    if (thread == RT_NULL)
+        return MEMTRACE_SLOT_MISC;
+
+    if (thread->mem_slot != RT_MEMTRACE_SLOT_NONE)
+        return thread->mem_slot;
+
+    for (index = MEMTRACE_SLOT_MISC + 1; index < RT_MEMTRACE_SLOT_MAX; index ++)
     {
-        if (name[index] == '\0') break;
-        mem->thread[index] = name[index];
+        stat = &memtrace_slot[index];
+        if (!memtrace_slot_alive(index) && stat->blocks == 0)
+        {
+            rt_memset(stat, 0, sizeof(struct rt_mem_thread_stat));
+            rt_strncpy(stat->name, thread->name, RT_NAME_MAX);
+            stat->thread = thread;
+            stat->tick   = rt_tick_get();
+            thread->mem_slot = index;
+
+            return index;
+        }
     }
 
-    for (; index < sizeof(mem->thread); index ++)
+    return MEMTRACE_SLOT_MISC;
+}
+
+static void memtrace_rate_update(struct rt_mem_thread_stat *stat)
+{
+    rt_tick_t tick = rt_tick_get() - stat->tick;
+
+    if (tick >= RT_TICK_PER_SECOND)
     {
-        mem->thread[index] = ' ';
+        stat->rate  = stat->count * RT_TICK_PER_SECOND / tick;
+        stat->count = 0;
+        stat->tick += tick;
     }
 }
+
+static void memtrace_alloc(struct heap_mem *mem, rt_size_t size)
+{
+    struct rt_mem_thread_stat *stat;
+
+    mem->slot = memtrace_slot_get(rt_thread_self());
+    stat = &memtrace_slot[mem->slot];
+
+    stat->used   += size;
+    stat->blocks += 1;
+    if (stat->max_used < stat->used)
+        stat->max_used = stat->used;
+    stat->count  += 1;
+    memtrace_rate_update(stat);
+}
+
+static void memtrace_free(struct heap_mem *mem, rt_size_t size)
+{
+    struct rt_mem_thread_stat *stat;
+
+    if (mem->slot >= RT_MEMTRACE_SLOT_MAX)
+        return;
+
+    stat = &memtrace_slot[mem->slot];
+    stat->used   -= size;
+    stat->blocks -= 1;
+    mem->slot     = RT_MEMTRACE_SLOT_NONE;
+}
 #endif
 
 static void plug_holes(struct heap_mem *mem)
@@ -224,7 +316,7 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
     mem->prev  = 0;
     mem->used  = 0;
 #ifdef RT_USING_MEMTRACE
-    rt_mem_setname(mem, "INIT");
+    mem->slot  = RT_MEMTRACE_SLOT_NONE;
 #endif
 
     /* initialize the end of the heap */
@@ -234,10 +326,17 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
     heap_end->next  = mem_size_aligned + SIZEOF_STRUCT_MEM;
     heap_end->prev  = mem_size_aligned + SIZEOF_STRUCT_MEM;
 #ifdef RT_USING_MEMTRACE
-    rt_mem_setname(heap_end, "INIT");
+    heap_end->slot  = RT_MEMTRACE_SLOT_NONE;
 #endif
 
     rt_sem_init(&heap_sem, "heap", 1, RT_IPC_FLAG_FIFO);
+#ifdef RT_USING_MEMPRESSURE
+    rt_mem_reclaim_init();
+#endif
+
+#ifdef RT_USING_MEMTRACE
+    memtrace_slot[MEMTRACE_SLOT_MISC].name[0] = '-';
+#endif
 
     /* initialize the lowest-free pointer to the start of the heap */
     lfree = (struct heap_mem *)heap_ptr;
@@ -260,6 +359,9 @@ void *rt_malloc(rt_size_t size)
 {
     rt_size_t ptr, ptr2;
     struct heap_mem *mem, *mem2;
+#ifdef RT_USING_MEMPRESSURE
+    rt_uint8_t reclaim_pass = 0;
+#endif
 
     if (size == 0)
         return RT_NULL;
@@ -286,6 +388,9 @@ void *rt_malloc(rt_size_t size)
     if (size < MIN_SIZE_ALIGNED)
         size = MIN_SIZE_ALIGNED;
 
+#ifdef RT_USING_MEMPRESSURE
+__retry:
+#endif
     /* take memory semaphore */
     rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
 
@@ -322,7 +427,7 @@ void *rt_malloc(rt_size_t size)
                 mem2->next = mem->next;
                 mem2->prev = ptr;
 #ifdef RT_USING_MEMTRACE
-                rt_mem_setname(mem2, "    ");
+                mem2->slot = RT_MEMTRACE_SLOT_NONE;
 #endif
 
                 /* and insert it between mem and mem->next */
@@ -358,10 +463,7 @@ void *rt_malloc(rt_size_t size)
             /* set memory block magic */
             mem->magic = HEAP_MAGIC;
 #ifdef RT_USING_MEMTRACE
-            if (rt_thread_self())
-                rt_mem_setname(mem, rt_thread_self()->name);
-            else
-                rt_mem_setname(mem, "NONE");
+            memtrace_alloc(mem, mem->next - ptr);
 #endif
 
             if (mem == lfree)
@@ -386,6 +488,10 @@ void *rt_malloc(rt_size_t size)
             RT_OBJECT_HOOK_CALL(rt_malloc_hook,
                                 (((void *)((rt_uint8_t *)mem + SIZEOF_STRUCT_MEM)), size));
 
+#if defined(RT_USING_MEMPRESSURE) && defined(RT_MEM_STATS)
+            rt_mem_pressure_check(mem_size_aligned, used_mem);
+#endif
+
             /* return the memory data except mem struct */
             return (rt_uint8_t *)mem + SIZEOF_STRUCT_MEM;
         }
@@ -393,6 +499,12 @@ void *rt_malloc(rt_size_t size)
 
     rt_sem_release(&heap_sem);
 
+#ifdef RT_USING_MEMPRESSURE
+    /* let the reclaim callbacks release memory, then try again */
+    if (reclaim_pass ++ < RT_MEM_RECLAIM_RETRY && rt_mem_reclaim(size) > 0)
+        goto __retry;
+#endif
+
     return RT_NULL;
 }
 RTM_EXPORT(rt_malloc);
@@ -469,7 +581,9 @@ void *rt_realloc(void *rmem, rt_size_t newsize)
         mem2->next = mem->next;
         mem2->prev = ptr;
 #ifdef RT_USING_MEMTRACE
-        rt_mem_setname(mem2, "    ");
+        mem2->slot = RT_MEMTRACE_SLOT_NONE;
+        if (mem->slot < RT_MEMTRACE_SLOT_MAX)
+            memtrace_slot[mem->slot].used -= (size - newsize);
 #endif
         mem->next = ptr2;
         if (mem2->next != mem_size_aligned + SIZEOF_STRUCT_MEM)
@@ -577,7 +691,7 @@ void rt_free(void *rmem)
     mem->used  = 0;
     mem->magic = HEAP_MAGIC;
 #ifdef RT_USING_MEMTRACE
-    rt_mem_setname(mem, "    ");
+    memtrace_free(mem, mem->next - ((rt_uint8_t *)mem - heap_ptr));
 #endif
 
     if (mem < lfree)
@@ -593,9 +707,83 @@ void rt_free(void *rmem)
     /* finally, see if prev or next are free also */
     plug_holes(mem);
     rt_sem_release(&heap_sem);
+
+#if defined(RT_USING_MEMPRESSURE) && defined(RT_MEM_STATS)
+    rt_mem_pressure_check(mem_size_aligned, used_mem);
+#endif
 }
 RTM_EXPORT(rt_free);
 
+#ifdef RT_USING_MEMTRACE
+/**
+ * This function will get the heap usage of a thread.
+ *
+ * @param thread the thread
+ * @param stat the heap usage of thread
+ *
+ * @return RT_EOK: get OK
+ *         -RT_ENOSYS: the thread has not allocated memory from heap yet
+ */
+rt_err_t rt_memtrace_thread_get(rt_thread_t thread, struct rt_mem_thread_stat *stat)
+{
+    rt_uint8_t slot;
+
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    slot = thread->mem_slot;
+    if (slot >= RT_MEMTRACE_SLOT_MAX)
+    {
+        rt_sem_release(&heap_sem);
+
+        return -RT_ENOSYS;
+    }
+
+    memtrace_rate_update(&memtrace_slot[slot]);
+    *stat = memtrace_slot[slot];
+
+    rt_sem_release(&heap_sem);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_memtrace_thread_get);
+
+/**
+ * This function will list the heap usage of threads. The threads which have
+ * exited but still own blocks are listed with a RT_NULL thread, and the first
+ * item collects the blocks allocated without thread context.
+ *
+ * @param stat the array to hold the heap usage
+ * @param max the size of array
+ *
+ * @return the number of items filled
+ */
+rt_size_t rt_memtrace_thread_list(struct rt_mem_thread_stat *stat, rt_size_t max)
+{
+    rt_size_t count = 0;
+    rt_uint8_t index;
+
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+
+    for (index = 0; index < RT_MEMTRACE_SLOT_MAX && count < max; index ++)
+    {
+        if (index != MEMTRACE_SLOT_MISC &&
+            !memtrace_slot_alive(index) && memtrace_slot[index].blocks == 0)
+            continue;
+
+        memtrace_rate_update(&memtrace_slot[index]);
+        stat[count ++] = memtrace_slot[index];
+    }
+
+    rt_sem_release(&heap_sem);
+
+    return count;
+}
+RTM_EXPORT(rt_memtrace_thread_list);
+#endif
+
 #ifdef RT_MEM_STATS
 void rt_memory_info(rt_uint32_t *total,
                     rt_uint32_t *used,
@@ -677,7 +865,10 @@ int memtrace(int argc, char **argv)
         else
             rt_kprintf("%4dM", size / (1024 * 1024));
 
-        rt_kprintf("] %c%c%c%c", mem->thread[0], mem->thread[1], mem->thread[2], mem->thread[3]);
+        if (mem->slot < RT_MEMTRACE_SLOT_MAX)
+            rt_kprintf("] %-*.*s", RT_NAME_MAX, RT_NAME_MAX, memtrace_slot[mem->slot].name);
+        else
+            rt_kprintf("] %-*s", RT_NAME_MAX, "");
         if (mem->magic != HEAP_MAGIC)
             rt_kprintf(": ***\n");
         else
@@ -687,6 +878,28 @@ int memtrace(int argc, char **argv)
     return 0;
 }
 MSH_CMD_EXPORT(memtrace, dump memory trace information);
+
+int memstat(int argc, char **argv)
+{
+    rt_size_t index, count;
+    static struct rt_mem_thread_stat stat[RT_MEMTRACE_SLOT_MAX];
+
+    count = rt_memtrace_thread_list(stat, RT_MEMTRACE_SLOT_MAX);
+
+    rt_kprintf("%-*.*s     used   blocks     peak  alloc/s\n", RT_NAME_MAX, RT_NAME_MAX, "thread");
+    for (index = 0; index < RT_NAME_MAX; index ++) rt_kprintf("-");
+    rt_kprintf(" -------- -------- -------- --------\n");
+    for (index = 0; index < count; index ++)
+    {
+        rt_kprintf("%-*.*s %8d %8d %8d %8d%s\n", RT_NAME_MAX, RT_NAME_MAX,
+                   stat[index].name, stat[index].used, stat[index].blocks,
+                   stat[index].max_used, stat[index].rate,
+                   (index != MEMTRACE_SLOT_MISC && stat[index].thread == RT_NULL) ? " (exited)" : "");
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(memstat, list heap usage of threads);
 #endif /* end of RT_USING_MEMTRACE */
 #endif /* end of RT_USING_FINSH    */
 
@@ -17,6 +17,9 @@
  * 2013-05-24     Bernard      fix the rt_memheap_realloc issue.
  * 2013-07-11     Grissiom     fix the memory block splitting issue.
  * 2013-07-15     Grissiom     optimize rt_memheap_realloc
+ * 2026-10-19     tangmenglin  add memory pressure check and reclaim retry
+ * 2026-10-19     tangmenglin  add malloc/free hooks and rt_memory_info for system heap
+ * 2026-10-19     tangmenglin  bound the reclaim retries
  */
 
 #include <rthw.h>
@@ -598,6 +601,44 @@ RTM_EXPORT(rt_memheap_free);
 #ifdef RT_USING_MEMHEAP_AS_HEAP
 static struct rt_memheap _heap;
 
+#ifdef RT_USING_HOOK
+static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
+static void (*rt_free_hook)(void *ptr);
+
+/**
+ * @addtogroup Hook
+ */
+
+/**@{*/
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is allocated from heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
+{
+    rt_malloc_hook = hook;
+}
+RTM_EXPORT(rt_malloc_sethook);
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is released to heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_free_sethook(void (*hook)(void *ptr))
+{
+    rt_free_hook = hook;
+}
+RTM_EXPORT(rt_free_sethook);
+
+/**@}*/
+
+#endif
+
 void rt_system_heap_init(void *begin_addr, void *end_addr)
 {
     /* initialize a default heap in the system */
@@ -605,12 +646,21 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
                     "heap",
                     begin_addr,
                     (rt_uint32_t)end_addr - (rt_uint32_t)begin_addr);
+#ifdef RT_USING_MEMPRESSURE
+    rt_mem_reclaim_init();
+#endif
 }
 
 void *rt_malloc(rt_size_t size)
 {
     void *ptr;
+#ifdef RT_USING_MEMPRESSURE
+    rt_uint8_t reclaim_pass = 0;
+#endif
 
+#ifdef RT_USING_MEMPRESSURE
+__retry:
+#endif
     /* try to allocate in system heap */
     ptr = rt_memheap_alloc(&_heap, size);
     if (ptr == RT_NULL)
@@ -643,13 +693,41 @@ void *rt_malloc(rt_size_t size)
         }
     }
 
+#ifdef RT_USING_MEMPRESSURE
+    if (ptr == RT_NULL)
+    {
+        /* let the reclaim callbacks release memory, then try again */
+        if (size != 0 && reclaim_pass ++ < RT_MEM_RECLAIM_RETRY &&
+            rt_mem_reclaim(size) > 0)
+            goto __retry;
+    }
+    else
+    {
+        rt_mem_pressure_check(_heap.pool_size,
+                              _heap.pool_size - _heap.available_size);
+    }
+#endif
+
+    if (ptr != RT_NULL)
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
+
     return ptr;
 }
 RTM_EXPORT(rt_malloc);
 
 void rt_free(void *rmem)
 {
+    if (rmem == RT_NULL)
+        return;
+
+    RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
+
     rt_memheap_free(rmem);
+
+#ifdef RT_USING_MEMPRESSURE
+    rt_mem_pressure_check(_heap.pool_size,
+                          _heap.pool_size - _heap.available_size);
+#endif
 }
 RTM_EXPORT(rt_free);
 
@@ -695,6 +773,18 @@ void *rt_realloc(void *rmem, rt_size_t newsize)
 }
 RTM_EXPORT(rt_realloc);
 
+void rt_memory_info(rt_uint32_t *total,
+                    rt_uint32_t *used,
+                    rt_uint32_t *max_used)
+{
+    if (total != RT_NULL)
+        *total = _heap.pool_size;
+    if (used  != RT_NULL)
+        *used = _heap.pool_size - _heap.available_size;
+    if (max_used != RT_NULL)
+        *max_used = _heap.max_used_size;
+}
+
 void *rt_calloc(rt_size_t count, rt_size_t size)
 {
     void *ptr;
@@ -14,6 +14,8 @@
  * 2010-10-26     yi.qiu       add module support in rt_mp_delete
  * 2011-01-24     Bernard      add object allocation check.
  * 2012-03-22     Bernard      fix align issue in rt_mp_init and rt_mp_create.
+ * 2026-10-19     tangmenglin  add lock-free memory pool for interrupt context.
+ * 2026-10-19     tangmenglin  lock-free memory pool only with A extension.
  */
 
 #include <rthw.h>
@@ -21,6 +23,15 @@
 
 #ifdef RT_USING_MEMPOOL
 
+/*
+ * The lock-free pool relies on LR/SC of the A extension. Without it every
+ * compare-and-swap would disable interrupt, and a few of them per call are
+ * slower than the locked pool, so rt_mp_init_lockfree makes a locked one.
+ */
+#if defined(RT_USING_MEMPOOL_LOCKFREE) && defined(__riscv_atomic)
+#define MP_USING_LOCKFREE
+#endif
+
 #ifdef RT_USING_HOOK
 static void (*rt_mp_alloc_hook)(struct rt_mempool *mp, void *block);
 static void (*rt_mp_free_hook)(struct rt_mempool *mp, void *block);
@@ -56,6 +67,222 @@ void rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block))
 /**@}*/
 #endif
 
+#ifdef MP_USING_LOCKFREE
+/*
+ * The free list of a lock-free pool is a stack of block indexes. The head
+ * word holds the index (plus 1) of the top block in its low bits and a tag
+ * in its high bits. Every push and pop bumps the tag, so a compare-and-swap
+ * over a stale head fails even when the same block is on top again (ABA).
+ *
+ * A free block keeps the index of the next free block in its header; an
+ * allocated block keeps the pool pointer, as in the locked pool.
+ */
+#define MP_INDEX_BITS           16
+#define MP_INDEX_MASK           ((1UL << MP_INDEX_BITS) - 1)
+#define MP_TAG_ONE              (1UL << MP_INDEX_BITS)
+
+#define MP_BLOCK_STRIDE(mp)     ((mp)->block_size + sizeof(rt_uint8_t *))
+#define MP_BLOCK(mp, index)     ((rt_uint8_t *)(mp)->start_address + \
+                                 ((index) - 1) * MP_BLOCK_STRIDE(mp))
+
+#ifdef ARCH_CPU_64BIT
+#define MP_LR                   "lr.d.aq"
+#define MP_SC                   "sc.d.rl"
+#else
+#define MP_LR                   "lr.w.aq"
+#define MP_SC                   "sc.w.rl"
+#endif
+
+rt_inline rt_bool_t _mp_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t new)
+{
+    rt_ubase_t value, fail;
+
+    __asm__ volatile (
+        "1: " MP_LR " %0, (%2)\n"
+        "   bne     %0, %3, 2f\n"
+        "   " MP_SC " %1, %4, (%2)\n"
+        "   bnez    %1, 1b\n"
+        "2:\n"
+        : "=&r"(value), "=&r"(fail)
+        : "r"(ptr), "r"(old), "r"(new)
+        : "memory");
+
+    return value == old;
+}
+
+rt_inline void _mp_add(volatile rt_size_t *ptr, rt_base_t value)
+{
+    __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED);
+}
+
+/* take one from the free block count, then a block is sure to be in list */
+static rt_bool_t _mp_lockfree_reserve(rt_mp_t mp)
+{
+    rt_size_t count;
+
+    do
+    {
+        count = *(volatile rt_size_t *)&mp->block_free_count;
+        if (count == 0)
+            return RT_FALSE;
+    } while (!_mp_cas(&mp->block_free_count, count, count - 1));
+
+    return RT_TRUE;
+}
+
+static rt_uint8_t *_mp_lockfree_pop(rt_mp_t mp)
+{
+    rt_ubase_t head, next;
+    rt_uint8_t *block_ptr;
+
+    do
+    {
+        head = *(volatile rt_ubase_t *)&mp->block_head;
+        RT_ASSERT((head & MP_INDEX_MASK) != 0);
+
+        /* the block may be taken by others meanwhile, then the tag changes
+         * and the compare-and-swap fails */
+        block_ptr = MP_BLOCK(mp, head & MP_INDEX_MASK);
+        next = *(volatile rt_ubase_t *)block_ptr;
+        next = ((head + MP_TAG_ONE) & ~MP_INDEX_MASK) | (next & MP_INDEX_MASK);
+    } while (!_mp_cas(&mp->block_head, head, next));
+
+    /* point to memory pool */
+    *(rt_uint8_t **)block_ptr = (rt_uint8_t *)mp;
+
+    return block_ptr;
+}
+
+static void _mp_lockfree_push(rt_mp_t mp, rt_uint8_t *block_ptr)
+{
+    rt_ubase_t head, index;
+
+    index = (block_ptr - (rt_uint8_t *)mp->start_address) / MP_BLOCK_STRIDE(mp) + 1;
+    do
+    {
+        head = *(volatile rt_ubase_t *)&mp->block_head;
+        *(volatile rt_ubase_t *)block_ptr = head & MP_INDEX_MASK;
+    } while (!_mp_cas(&mp->block_head, head,
+                      ((head + MP_TAG_ONE) & ~MP_INDEX_MASK) | index));
+
+    /* count the block after it is in list */
+    _mp_add(&mp->block_free_count, 1);
+}
+
+static void *_mp_lockfree_alloc(rt_mp_t mp, rt_int32_t time)
+{
+    rt_uint8_t *block_ptr;
+    register rt_base_t level;
+    struct rt_thread *thread;
+    rt_uint32_t before_sleep = 0;
+
+    while (!_mp_lockfree_reserve(mp))
+    {
+        /* memory block is unavailable. */
+        if (time == 0)
+        {
+            rt_set_errno(-RT_ETIMEOUT);
+
+            return RT_NULL;
+        }
+
+        RT_DEBUG_NOT_IN_INTERRUPT;
+
+        /* get current thread */
+        thread = rt_thread_self();
+
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        /* a block was released before interrupt is disabled */
+        if (mp->block_free_count != 0)
+        {
+            rt_hw_interrupt_enable(level);
+            continue;
+        }
+
+        thread->error = RT_EOK;
+
+        /* need suspend thread */
+        rt_thread_suspend(thread);
+        rt_list_insert_after(&(mp->suspend_thread), &(thread->tlist));
+        mp->suspend_thread_count++;
+
+        if (time > 0)
+        {
+            /* get the start tick of timer */
+            before_sleep = rt_tick_get();
+
+            /* init thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &time);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        /* do a schedule */
+        rt_schedule();
+
+        if (thread->error != RT_EOK)
+            return RT_NULL;
+
+        if (time > 0)
+        {
+            time -= rt_tick_get() - before_sleep;
+            if (time < 0)
+                time = 0;
+        }
+    }
+
+    block_ptr = _mp_lockfree_pop(mp);
+
+    RT_OBJECT_HOOK_CALL(rt_mp_alloc_hook,
+                        (mp, (rt_uint8_t *)(block_ptr + sizeof(rt_uint8_t *))));
+
+    return (rt_uint8_t *)(block_ptr + sizeof(rt_uint8_t *));
+}
+#endif
+
+static void _mp_block_list_init(rt_mp_t mp)
+{
+    rt_uint8_t *block_ptr;
+    register rt_size_t offset;
+    rt_size_t block_size = mp->block_size;
+
+    block_ptr = (rt_uint8_t *)mp->start_address;
+
+#ifdef MP_USING_LOCKFREE
+    if (mp->parent.flag & RT_MP_FLAG_LOCKFREE)
+    {
+        /* link the blocks by index, block 1 on top */
+        for (offset = 0; offset < mp->block_total_count; offset ++)
+        {
+            *(rt_ubase_t *)(block_ptr + offset * (block_size + sizeof(rt_uint8_t *))) =
+                offset + 1 < mp->block_total_count ? offset + 2 : 0;
+        }
+        mp->block_head = mp->block_total_count ? 1 : 0;
+        mp->block_list = RT_NULL;
+
+        return;
+    }
+#endif
+
+    /* initialize free block list */
+    for (offset = 0; offset < mp->block_total_count; offset ++)
+    {
+        *(rt_uint8_t **)(block_ptr + offset * (block_size + sizeof(rt_uint8_t *))) =
+            (rt_uint8_t *)(block_ptr + (offset + 1) * (block_size + sizeof(rt_uint8_t *)));
+    }
+
+    *(rt_uint8_t **)(block_ptr + (offset - 1) * (block_size + sizeof(rt_uint8_t *))) =
+        RT_NULL;
+
+    mp->block_list = block_ptr;
+}
+
 /**
  * @addtogroup MM
  */
@@ -80,9 +307,6 @@ rt_err_t rt_mp_init(struct rt_mempool *mp,
                     rt_size_t          size,
                     rt_size_t          block_size)
 {
-    rt_uint8_t *block_ptr;
-    register rt_size_t offset;
-
     /* parameter check */
     RT_ASSERT(mp != RT_NULL);
 
@@ -106,21 +330,72 @@ rt_err_t rt_mp_init(struct rt_mempool *mp,
     mp->suspend_thread_count = 0;
 
     /* initialize free block list */
-    block_ptr = (rt_uint8_t *)mp->start_address;
-    for (offset = 0; offset < mp->block_total_count; offset ++)
-    {
-        *(rt_uint8_t **)(block_ptr + offset * (block_size + sizeof(rt_uint8_t *))) =
-            (rt_uint8_t *)(block_ptr + (offset + 1) * (block_size + sizeof(rt_uint8_t *)));
-    }
+    _mp_block_list_init(mp);
 
-    *(rt_uint8_t **)(block_ptr + (offset - 1) * (block_size + sizeof(rt_uint8_t *))) =
-        RT_NULL;
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mp_init);
 
-    mp->block_list = block_ptr;
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+/**
+ * This function will initialize a lock-free memory pool object. Its blocks
+ * can be allocated and released in interrupt context in bounded time, and
+ * an allocation from an empty pool returns RT_NULL at once if no waiting time
+ * is given.
+ *
+ * Without the A extension it initializes a locked pool, whose allocation
+ * with no waiting time and release are also safe in interrupt context.
+ *
+ * @param mp the memory pool object
+ * @param name the name of memory pool
+ * @param start the star address of memory pool
+ * @param size the total size of memory pool
+ * @param block_size the size for each block
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_mp_init_lockfree(struct rt_mempool *mp,
+                             const char        *name,
+                             void              *start,
+                             rt_size_t          size,
+                             rt_size_t          block_size)
+{
+#ifndef MP_USING_LOCKFREE
+    return rt_mp_init(mp, name, start, size, block_size);
+#else
+    /* parameter check */
+    RT_ASSERT(mp != RT_NULL);
+
+    /* initialize object */
+    rt_object_init(&(mp->parent), RT_Object_Class_MemPool, name);
+    mp->parent.flag |= RT_MP_FLAG_LOCKFREE;
+
+    /* initialize memory pool */
+    mp->start_address = start;
+    mp->size = RT_ALIGN_DOWN(size, RT_ALIGN_SIZE);
+
+    /* align the block size */
+    block_size = RT_ALIGN(block_size, RT_ALIGN_SIZE);
+    mp->block_size = block_size;
+
+    /* the block index must fit into the head word */
+    mp->block_total_count = mp->size / (mp->block_size + sizeof(rt_uint8_t *));
+    if (mp->block_total_count > MP_INDEX_MASK)
+        mp->block_total_count = MP_INDEX_MASK;
+    mp->block_free_count  = mp->block_total_count;
+
+    /* initialize suspended thread list */
+    rt_list_init(&(mp->suspend_thread));
+    mp->suspend_thread_count = 0;
+
+    /* initialize free block list */
+    _mp_block_list_init(mp);
 
     return RT_EOK;
+#endif
 }
-RTM_EXPORT(rt_mp_init);
+RTM_EXPORT(rt_mp_init_lockfree);
+#endif
 
 /**
  * This function will detach a memory pool from system object management.
@@ -186,9 +461,7 @@ rt_mp_t rt_mp_create(const char *name,
                      rt_size_t   block_count,
                      rt_size_t   block_size)
 {
-    rt_uint8_t *block_ptr;
     struct rt_mempool *mp;
-    register rt_size_t offset;
 
     RT_DEBUG_NOT_IN_INTERRUPT;
 
@@ -222,17 +495,7 @@ rt_mp_t rt_mp_create(const char *name,
     mp->suspend_thread_count = 0;
 
     /* initialize free block list */
-    block_ptr = (rt_uint8_t *)mp->start_address;
-    for (offset = 0; offset < mp->block_total_count; offset ++)
-    {
-        *(rt_uint8_t **)(block_ptr + offset * (block_size + sizeof(rt_uint8_t *)))
-            = block_ptr + (offset + 1) * (block_size + sizeof(rt_uint8_t *));
-    }
-
-    *(rt_uint8_t **)(block_ptr + (offset - 1) * (block_size + sizeof(rt_uint8_t *)))
-        = RT_NULL;
-
-    mp->block_list = block_ptr;
+    _mp_block_list_init(mp);
 
     return mp;
 }
@@ -308,6 +571,11 @@ void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
     struct rt_thread *thread;
     rt_uint32_t before_sleep = 0;
 
+#ifdef MP_USING_LOCKFREE
+    if (mp->parent.flag & RT_MP_FLAG_LOCKFREE)
+        return _mp_lockfree_alloc(mp, time);
+#endif
+
     /* get current thread */
     thread = rt_thread_self();
 
@@ -408,15 +676,32 @@ void rt_mp_free(void *block)
 
     RT_OBJECT_HOOK_CALL(rt_mp_free_hook, (mp, block));
 
+#ifdef MP_USING_LOCKFREE
+    if (mp->parent.flag & RT_MP_FLAG_LOCKFREE)
+    {
+        _mp_lockfree_push(mp, (rt_uint8_t *)block_ptr);
+
+        /* no thread waits on a pool which is only used in interrupt */
+        if (mp->suspend_thread_count == 0)
+            return;
+    }
+#endif
+
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    /* increase the free block count */
-    mp->block_free_count ++;
+#ifdef MP_USING_LOCKFREE
+    /* the block of lock-free pool has been linked into the list */
+    if (!(mp->parent.flag & RT_MP_FLAG_LOCKFREE))
+#endif
+    {
+        /* increase the free block count */
+        mp->block_free_count ++;
 
-    /* link the block into the block list */
-    *block_ptr = mp->block_list;
-    mp->block_list = (rt_uint8_t *)block_ptr;
+        /* link the block into the block list */
+        *block_ptr = mp->block_list;
+        mp->block_list = (rt_uint8_t *)block_ptr;
+    }
 
     if (mp->suspend_thread_count > 0)
     {
@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ * 2026-10-19     tangmenglin  wait for the running reclaim, bound the retries
+ */
+
+/*
+ * Memory pressure notification and reclaim callbacks.
+ *
+ * The system heap (mem.c, slab.c or memheap.c) reports its usage through
+ * rt_mem_pressure_check() after each allocation and release. When the free
+ * memory crosses the low or critical watermark, the new level is posted to
+ * every subscribed mailbox, so caches may shrink before allocations fail.
+ *
+ * When an allocation can not be satisfied, the heap invokes rt_mem_reclaim()
+ * before returning RT_NULL. The registered reclaim callbacks release whatever
+ * memory they can and the heap retries the allocation, at most
+ * RT_MEM_RECLAIM_RETRY times. One reclaim runs at a time: an allocation
+ * failing meanwhile waits for it and retries with the memory it released.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_HEAP) && defined(RT_USING_MEMPRESSURE)
+
+#ifndef RT_MEM_RECLAIM_LIST_SIZE
+#define RT_MEM_RECLAIM_LIST_SIZE        4
+#endif
+
+#ifndef RT_MEM_PRESSURE_SUBSCRIBER_SIZE
+#define RT_MEM_PRESSURE_SUBSCRIBER_SIZE 4
+#endif
+
+/* watermarks in percent of free heap memory */
+#ifndef RT_MEM_PRESSURE_LOW_WATERMARK
+#define RT_MEM_PRESSURE_LOW_WATERMARK       25
+#endif
+
+#ifndef RT_MEM_PRESSURE_CRITICAL_WATERMARK
+#define RT_MEM_PRESSURE_CRITICAL_WATERMARK  10
+#endif
+
+struct rt_mem_reclaim_item
+{
+    rt_size_t (*reclaim)(rt_size_t size, void *parameter);
+    void      *parameter;
+};
+
+static struct rt_mem_reclaim_item reclaim_list[RT_MEM_RECLAIM_LIST_SIZE];
+
+/* the running reclaim, the waiters block on reclaim_sem */
+static struct rt_semaphore reclaim_sem;
+static rt_thread_t reclaim_owner;
+static rt_uint8_t  reclaim_running;
+static rt_uint32_t reclaim_seq;
+static rt_size_t   reclaim_total;
+
+#ifdef RT_USING_MAILBOX
+static rt_mailbox_t subscriber_list[RT_MEM_PRESSURE_SUBSCRIBER_SIZE];
+#endif
+
+static rt_uint8_t low_watermark      = RT_MEM_PRESSURE_LOW_WATERMARK;
+static rt_uint8_t critical_watermark = RT_MEM_PRESSURE_CRITICAL_WATERMARK;
+static rt_uint8_t pressure_level     = RT_MEM_PRESSURE_NORMAL;
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * This function will initialize the reclaim, it's invoked by
+ * rt_system_heap_init.
+ */
+void rt_mem_reclaim_init(void)
+{
+    rt_sem_init(&reclaim_sem, "reclaim", 1, RT_IPC_FLAG_FIFO);
+}
+
+/**
+ * This function will register a reclaim callback, which will be invoked when
+ * the system heap fails to satisfy an allocation.
+ *
+ * The callback shall release memory back to the system heap and return the
+ * number of bytes released, or 0 when nothing more can be released.
+ *
+ * @param reclaim the reclaim callback
+ * @param parameter the parameter of reclaim callback
+ *
+ * @return RT_EOK: register OK
+ *         -RT_EFULL: reclaim list is full
+ */
+rt_err_t rt_mem_reclaim_register(rt_size_t (*reclaim)(rt_size_t size, void *parameter),
+                                 void *parameter)
+{
+    rt_size_t i;
+    rt_base_t level;
+    rt_err_t ret = -RT_EFULL;
+
+    RT_ASSERT(reclaim != RT_NULL);
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (i = 0; i < RT_MEM_RECLAIM_LIST_SIZE; i++)
+    {
+        if (reclaim_list[i].reclaim == RT_NULL)
+        {
+            reclaim_list[i].reclaim   = reclaim;
+            reclaim_list[i].parameter = parameter;
+            ret = RT_EOK;
+            break;
+        }
+    }
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return ret;
+}
+RTM_EXPORT(rt_mem_reclaim_register);
+
+/**
+ * This function will remove a reclaim callback from reclaim list.
+ *
+ * @param reclaim the reclaim callback
+ *
+ * @return RT_EOK: remove OK
+ *         -RT_ENOSYS: reclaim callback was not found
+ */
+rt_err_t rt_mem_reclaim_unregister(rt_size_t (*reclaim)(rt_size_t size, void *parameter))
+{
+    rt_size_t i;
+    rt_base_t level;
+    rt_err_t ret = -RT_ENOSYS;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (i = 0; i < RT_MEM_RECLAIM_LIST_SIZE; i++)
+    {
+        if (reclaim_list[i].reclaim == reclaim)
+        {
+            reclaim_list[i].reclaim   = RT_NULL;
+            reclaim_list[i].parameter = RT_NULL;
+            ret = RT_EOK;
+            break;
+        }
+    }
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return ret;
+}
+RTM_EXPORT(rt_mem_reclaim_unregister);
+
+/**
+ * This function will invoke all of reclaim callbacks. It's invoked by the
+ * system heap without heap lock held, before an allocation fails.
+ *
+ * If another thread is running the reclaim callbacks, it waits for them
+ * and returns the bytes they released instead of invoking them again.
+ *
+ * @param size the size of allocation which can not be satisfied
+ *
+ * @return the total bytes released by reclaim callbacks
+ */
+rt_size_t rt_mem_reclaim(rt_size_t size)
+{
+    rt_size_t i, total = 0;
+    rt_base_t level;
+    rt_uint32_t seq;
+    struct rt_mem_reclaim_item item;
+
+    /* a reclaim callback may allocate memory, do not recurse */
+    level = rt_hw_interrupt_disable();
+    if (reclaim_running && reclaim_owner == rt_thread_self())
+    {
+        rt_hw_interrupt_enable(level);
+
+        return 0;
+    }
+    seq = reclaim_seq;
+    rt_hw_interrupt_enable(level);
+
+    rt_sem_take(&reclaim_sem, RT_WAITING_FOREVER);
+
+    /* a reclaim finished while waiting, retry with what it released */
+    if (reclaim_seq != seq)
+    {
+        total = reclaim_total;
+        rt_sem_release(&reclaim_sem);
+
+        return total;
+    }
+
+    level = rt_hw_interrupt_disable();
+    reclaim_owner   = rt_thread_self();
+    reclaim_running = 1;
+    rt_hw_interrupt_enable(level);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("reclaim memory for size %d\n", size));
+
+    for (i = 0; i < RT_MEM_RECLAIM_LIST_SIZE; i++)
+    {
+        level = rt_hw_interrupt_disable();
+        item = reclaim_list[i];
+        rt_hw_interrupt_enable(level);
+
+        if (item.reclaim != RT_NULL)
+            total += item.reclaim(size, item.parameter);
+    }
+
+    level = rt_hw_interrupt_disable();
+    reclaim_running = 0;
+    reclaim_owner   = RT_NULL;
+    reclaim_total   = total;
+    reclaim_seq ++;
+    rt_hw_interrupt_enable(level);
+
+    rt_sem_release(&reclaim_sem);
+
+    return total;
+}
+
+#ifdef RT_USING_MAILBOX
+/**
+ * This function will subscribe memory pressure events. When the pressure
+ * level changes, the new level (enum rt_mem_pressure_level) is sent to the
+ * mailbox.
+ *
+ * @param mb the mailbox to receive memory pressure level
+ *
+ * @return RT_EOK: subscribe OK
+ *         -RT_EFULL: subscriber list is full
+ */
+rt_err_t rt_mem_pressure_subscribe(rt_mailbox_t mb)
+{
+    rt_size_t i;
+    rt_base_t level;
+    rt_err_t ret = -RT_EFULL;
+
+    RT_ASSERT(mb != RT_NULL);
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (i = 0; i < RT_MEM_PRESSURE_SUBSCRIBER_SIZE; i++)
+    {
+        if (subscriber_list[i] == RT_NULL)
+        {
+            subscriber_list[i] = mb;
+            ret = RT_EOK;
+            break;
+        }
+    }
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return ret;
+}
+RTM_EXPORT(rt_mem_pressure_subscribe);
+
+/**
+ * This function will unsubscribe memory pressure events.
+ *
+ * @param mb the subscribed mailbox
+ *
+ * @return RT_EOK: unsubscribe OK
+ *         -RT_ENOSYS: mailbox was not found
+ */
+rt_err_t rt_mem_pressure_unsubscribe(rt_mailbox_t mb)
+{
+    rt_size_t i;
+    rt_base_t level;
+    rt_err_t ret = -RT_ENOSYS;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (i = 0; i < RT_MEM_PRESSURE_SUBSCRIBER_SIZE; i++)
+    {
+        if (subscriber_list[i] == mb)
+        {
+            subscriber_list[i] = RT_NULL;
+            ret = RT_EOK;
+            break;
+        }
+    }
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return ret;
+}
+RTM_EXPORT(rt_mem_pressure_unsubscribe);
+#endif
+
+/**
+ * This function will set the watermarks of memory pressure.
+ *
+ * @param low the low watermark, in percent of free heap memory
+ * @param critical the critical watermark, in percent of free heap memory
+ *
+ * @return RT_EOK: set OK
+ *         -RT_EINVAL: invalid watermarks
+ */
+rt_err_t rt_mem_pressure_set_watermark(rt_uint8_t low, rt_uint8_t critical)
+{
+    rt_base_t level;
+
+    if (low > 100 || critical > low)
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+    low_watermark      = low;
+    critical_watermark = critical;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mem_pressure_set_watermark);
+
+/**
+ * This function will return current memory pressure level.
+ *
+ * @return the memory pressure level
+ */
+rt_uint8_t rt_mem_pressure_get_level(void)
+{
+    return pressure_level;
+}
+RTM_EXPORT(rt_mem_pressure_get_level);
+
+/**
+ * This function will check the usage of system heap against the watermarks,
+ * and notify the subscribers if the pressure level changes. It's invoked by
+ * the system heap without heap lock held.
+ *
+ * @param total the total size of system heap
+ * @param used the used size of system heap
+ */
+void rt_mem_pressure_check(rt_size_t total, rt_size_t used)
+{
+    rt_base_t level;
+    rt_uint8_t new_level;
+    rt_uint32_t free_size;
+
+    if (total == 0)
+        return;
+
+    free_size = total - used;
+    /* keep the products below in 32 bits, avoid 64-bit division on RV32 */
+    while (total > 0x00ffffff)
+    {
+        total     >>= 1;
+        free_size >>= 1;
+    }
+
+    if (free_size * 100 < total * critical_watermark)
+        new_level = RT_MEM_PRESSURE_CRITICAL;
+    else if (free_size * 100 < total * low_watermark)
+        new_level = RT_MEM_PRESSURE_LOW;
+    else
+        new_level = RT_MEM_PRESSURE_NORMAL;
+
+    level = rt_hw_interrupt_disable();
+    if (new_level == pressure_level)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return;
+    }
+    pressure_level = new_level;
+    rt_hw_interrupt_enable(level);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("memory pressure level %d, free %d\n",
+                                new_level, free_size));
+
+#ifdef RT_USING_MAILBOX
+    {
+        rt_size_t i;
+
+        for (i = 0; i < RT_MEM_PRESSURE_SUBSCRIBER_SIZE; i++)
+        {
+            rt_mailbox_t mb = subscriber_list[i];
+
+            /* the event is dropped when the mailbox is full */
+            if (mb != RT_NULL)
+                rt_mb_send(mb, new_level);
+        }
+    }
+#endif
+}
+
+/**@}*/
+
+#endif /* end of RT_USING_MEMPRESSURE */
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ * 2026-10-19     tangmenglin  dump with direct rt_kprintf, out of critical section.
+ */
+
+/*
+ * Heap allocation trace recorder.
+ *
+ * The recorder installs the malloc and free hooks of the system heap and
+ * logs each operation as a 16 bytes record (timestamp, thread, block address
+ * and size) into a ring buffer. A release is recorded with size 0, and the
+ * block address identifies the allocation it belongs to.
+ *
+ * The records are drained by rt_memrecord_read() or dumped in hex by the
+ * memrecord shell command, then replayed against mem.c, slab.c and memheap.c
+ * on the host by tools/heapsim/replay.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_HEAP) && defined(RT_USING_MEMRECORD)
+
+#ifndef RT_USING_HOOK
+#error "RT_USING_MEMRECORD requires RT_USING_HOOK"
+#endif
+
+#ifndef RT_MEMRECORD_BUF_SIZE
+#define RT_MEMRECORD_BUF_SIZE       256
+#endif
+
+/* the threads named in a dump, the others show as addresses */
+#ifndef RT_MEMRECORD_THREADS
+#define RT_MEMRECORD_THREADS        32
+#endif
+
+/* the timestamp of record, a BSP may use a cycle counter instead */
+#ifndef RT_MEMRECORD_TIMESTAMP
+#define RT_MEMRECORD_TIMESTAMP()    rt_tick_get()
+#endif
+
+static struct rt_memrecord_item record_buf[RT_MEMRECORD_BUF_SIZE];
+static rt_uint16_t record_read;
+static rt_uint16_t record_count;
+static rt_uint32_t record_dropped;
+
+static void memrecord_put(void *ptr, rt_size_t size)
+{
+    rt_base_t level;
+    rt_uint16_t index;
+    struct rt_memrecord_item *item;
+
+    level = rt_hw_interrupt_disable();
+    if (record_count == RT_MEMRECORD_BUF_SIZE)
+    {
+        /* keep the recorded prefix consistent, drop the new record */
+        record_dropped ++;
+        rt_hw_interrupt_enable(level);
+
+        return;
+    }
+
+    index = record_read + record_count;
+    if (index >= RT_MEMRECORD_BUF_SIZE)
+        index -= RT_MEMRECORD_BUF_SIZE;
+    record_count ++;
+
+    item = &record_buf[index];
+    item->timestamp = RT_MEMRECORD_TIMESTAMP();
+    item->thread    = (rt_uint32_t)rt_thread_self();
+    item->ptr       = (rt_uint32_t)ptr;
+    item->size      = size;
+    rt_hw_interrupt_enable(level);
+}
+
+static void memrecord_malloc_hook(void *ptr, rt_size_t size)
+{
+    memrecord_put(ptr, size);
+}
+
+static void memrecord_free_hook(void *ptr)
+{
+    memrecord_put(ptr, 0);
+}
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * This function will start recording heap allocations. It installs the
+ * malloc and free hooks of system heap.
+ */
+void rt_memrecord_start(void)
+{
+    rt_malloc_sethook(memrecord_malloc_hook);
+    rt_free_sethook(memrecord_free_hook);
+}
+RTM_EXPORT(rt_memrecord_start);
+
+/**
+ * This function will stop recording heap allocations. The records in ring
+ * buffer are kept until they are read or cleared.
+ */
+void rt_memrecord_stop(void)
+{
+    rt_malloc_sethook(RT_NULL);
+    rt_free_sethook(RT_NULL);
+}
+RTM_EXPORT(rt_memrecord_stop);
+
+/**
+ * This function will discard all of records and reset the drop counter.
+ */
+void rt_memrecord_clear(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    record_read    = 0;
+    record_count   = 0;
+    record_dropped = 0;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_memrecord_clear);
+
+/**
+ * This function will read out the oldest records from ring buffer.
+ *
+ * @param buffer the buffer to hold records
+ * @param count the maximum number of records to read
+ *
+ * @return the number of records read
+ */
+rt_size_t rt_memrecord_read(struct rt_memrecord_item *buffer, rt_size_t count)
+{
+    rt_size_t index;
+    rt_base_t level;
+
+    RT_ASSERT(buffer != RT_NULL);
+
+    for (index = 0; index < count; index ++)
+    {
+        level = rt_hw_interrupt_disable();
+        if (record_count == 0)
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+
+        buffer[index] = record_buf[record_read];
+        record_read ++;
+        if (record_read == RT_MEMRECORD_BUF_SIZE)
+            record_read = 0;
+        record_count --;
+        rt_hw_interrupt_enable(level);
+    }
+
+    return index;
+}
+RTM_EXPORT(rt_memrecord_read);
+
+/**
+ * This function will return the number of records dropped because the ring
+ * buffer was full.
+ *
+ * @return the number of dropped records
+ */
+rt_uint32_t rt_memrecord_dropped(void)
+{
+    return record_dropped;
+}
+RTM_EXPORT(rt_memrecord_dropped);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+struct memrecord_thread
+{
+    rt_uint32_t address;
+    char name[RT_NAME_MAX];
+};
+
+static struct memrecord_thread memrecord_threads[RT_MEMRECORD_THREADS];
+
+/* copy the thread map, which resolves the thread field of records */
+static int memrecord_threads_get(void)
+{
+    struct rt_list_node *node;
+    struct rt_object_information *information;
+    struct rt_object *object;
+    int count = 0;
+
+    information = rt_object_get_information(RT_Object_Class_Thread);
+    rt_enter_critical();
+    for (node  = information->object_list.next;
+         node != &(information->object_list) && count < RT_MEMRECORD_THREADS;
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+
+        memrecord_threads[count].address = (rt_uint32_t)object;
+        rt_memcpy(memrecord_threads[count].name, object->name, RT_NAME_MAX);
+        count ++;
+    }
+    rt_exit_critical();
+
+    return count;
+}
+
+static void memrecord_dump(void)
+{
+    struct rt_memrecord_item item;
+    int index, count;
+
+    /*
+     * the records are removed as they are read, the ring of asynchronous
+     * rt_kprintf would drop them for good
+     */
+    rt_kprintf_sync(RT_TRUE);
+
+    rt_kprintf("# memrecord: %d records, %d dropped, %d ticks per second\n",
+               record_count, record_dropped, RT_TICK_PER_SECOND);
+
+    count = memrecord_threads_get();
+    for (index = 0; index < count; index++)
+    {
+        rt_kprintf("T %08x %.*s\n", memrecord_threads[index].address,
+                   RT_NAME_MAX, memrecord_threads[index].name);
+    }
+
+    while (rt_memrecord_read(&item, 1) == 1)
+    {
+        rt_kprintf("%08x %08x %08x %08x\n",
+                   item.timestamp, item.thread, item.ptr, item.size);
+    }
+
+    rt_kprintf_sync(RT_FALSE);
+}
+
+int memrecord(int argc, char **argv)
+{
+    if (argc == 2)
+    {
+        if (!rt_strcmp(argv[1], "start"))
+        {
+            rt_memrecord_start();
+            return 0;
+        }
+        else if (!rt_strcmp(argv[1], "stop"))
+        {
+            rt_memrecord_stop();
+            return 0;
+        }
+        else if (!rt_strcmp(argv[1], "clear"))
+        {
+            rt_memrecord_clear();
+            return 0;
+        }
+        else if (!rt_strcmp(argv[1], "dump"))
+        {
+            memrecord_dump();
+            return 0;
+        }
+    }
+
+    rt_kprintf("usage: memrecord start|stop|clear|dump\n");
+
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(memrecord, record heap allocations: start|stop|clear|dump);
+#endif /* end of RT_USING_FINSH */
+
+#endif /* end of RT_USING_MEMRECORD */
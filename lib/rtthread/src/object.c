@@ -13,6 +13,8 @@
  * 2010-10-26     yi.qiu       add module support in rt_object_allocate and rt_object_free
  * 2017-12-10     Bernard      Add object_info enum.
  * 2018-01-25     Bernard      Fix the object find issue when enable MODULE.
+ * 2026-10-19     tangmenglin  index objects by hash of name
+ * 2026-10-19     tangmenglin  add anonymous objects out of container
  */
 
 #include <rtthread.h>
@@ -105,6 +107,44 @@ static struct rt_object_information rt_object_container[RT_Object_Info_Unknown]
 #endif
 };
 
+#ifdef RT_USING_OBJECT_HASH
+/*
+ * Each object class keeps its objects in RT_OBJECT_HASH_SIZE buckets by the
+ * FNV-1a hash of name, chained by hash_next. A name is compared in at most
+ * RT_NAME_MAX characters, so it is hashed in as many.
+ */
+static rt_uint32_t _object_hash(const char *name)
+{
+    rt_uint32_t hash = 2166136261UL;
+    int index;
+
+    for (index = 0; index < RT_NAME_MAX && name[index] != '\0'; index ++)
+    {
+        hash ^= (rt_uint8_t)name[index];
+        hash *= 16777619UL;
+    }
+
+    return (hash ^ (hash >> 16)) & (RT_OBJECT_HASH_SIZE - 1);
+}
+
+/* it must be invoked with interrupt disabled */
+static void _object_hash_remove(struct rt_object_information *information,
+                                struct rt_object *object,
+                                rt_uint32_t hash)
+{
+    struct rt_object **link;
+
+    for (link = &(information->hash[hash]); *link != RT_NULL; link = &((*link)->hash_next))
+    {
+        if (*link == object)
+        {
+            *link = object->hash_next;
+            break;
+        }
+    }
+}
+#endif
+
 #ifdef RT_USING_HOOK
 static void (*rt_object_attach_hook)(struct rt_object *object);
 static void (*rt_object_detach_hook)(struct rt_object *object);
@@ -234,14 +274,18 @@ RTM_EXPORT(rt_object_get_information);
  * @param object the specified object to be initialized.
  * @param type the object type.
  * @param name the object name. In system, the object's name must be unique.
+ *        RT_NULL for an anonymous object, which is not put in object
+ *        container and can not be found by name.
  */
 void rt_object_init(struct rt_object         *object,
                     enum rt_object_class_type type,
                     const char               *name)
 {
     register rt_base_t temp;
-    struct rt_list_node *node = RT_NULL;
     struct rt_object_information *information;
+#ifdef RT_USING_OBJECT_HASH
+    rt_uint32_t hash;
+#endif
 #ifdef RT_USING_MODULE
     struct rt_dlmodule *module = dlmodule_self();
 #endif
@@ -250,28 +294,61 @@ void rt_object_init(struct rt_object         *object,
     information = rt_object_get_information(type);
     RT_ASSERT(information != RT_NULL);
 
-    /* check object type to avoid re-initialization */
+    if (name == RT_NULL)
+    {
+        object->type = type | RT_Object_Class_Static;
+        object->name[0] = '\0';
+#ifdef RT_USING_OBJECT_HASH
+        object->hash_next = RT_NULL;
+#endif
 
-    /* enter critical */
-    rt_enter_critical();
-    /* try to find object */
-    for (node  = information->object_list.next;
-            node != &(information->object_list);
-            node  = node->next)
+        RT_OBJECT_HOOK_CALL(rt_object_attach_hook, (object));
+
+#ifdef RT_DEBUG_ANONYMOUS_OBJECT
+        /* in object list for list commands, but not in any name bucket */
+        temp = rt_hw_interrupt_disable();
+        rt_list_insert_after(&(information->object_list), &(object->list));
+        rt_hw_interrupt_enable(temp);
+#else
+        /* out of container, which rt_object_detach tells by the empty list */
+        rt_list_init(&(object->list));
+#endif
+
+        return;
+    }
+
+#ifdef RT_DEBUG
     {
-        struct rt_object *obj;
+        struct rt_list_node *node = RT_NULL;
+
+        /* check object type to avoid re-initialization */
+
+        /* enter critical */
+        rt_enter_critical();
+        /* try to find object */
+        for (node  = information->object_list.next;
+                node != &(information->object_list);
+                node  = node->next)
+        {
+            struct rt_object *obj;
 
-        obj = rt_list_entry(node, struct rt_object, list);
-        RT_ASSERT(obj != object);
+            obj = rt_list_entry(node, struct rt_object, list);
+            RT_ASSERT(obj != object);
+        }
+        /* leave critical */
+        rt_exit_critical();
     }
-    /* leave critical */
-    rt_exit_critical();
+#endif
 
     /* initialize object's parameters */
     /* set object type to static */
     object->type = type | RT_Object_Class_Static;
     /* copy name */
     rt_strncpy(object->name, name, RT_NAME_MAX);
+#ifdef RT_USING_OBJECT_HASH
+    object->hash_next = RT_NULL;
+    hash = _object_hash(object->name);
+#endif
 
     RT_OBJECT_HOOK_CALL(rt_object_attach_hook, (object));
 
@@ -289,6 +366,11 @@ void rt_object_init(struct rt_object         *object,
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        /* and into its name bucket, the newest first as in the list */
+        object->hash_next = information->hash[hash];
+        information->hash[hash] = object;
+#endif
     }
 
     /* unlock interrupt */
@@ -304,12 +386,29 @@ void rt_object_init(struct rt_object         *object,
 void rt_object_detach(rt_object_t object)
 {
     register rt_base_t temp;
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object_information *information;
+    rt_uint32_t hash;
+#endif
 
     /* object check */
     RT_ASSERT(object != RT_NULL);
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
+    /* an anonymous object is not in container */
+    if (rt_list_isempty(&(object->list)))
+    {
+        object->type = 0;
+
+        return;
+    }
+
+#ifdef RT_USING_OBJECT_HASH
+    information = rt_object_get_information((enum rt_object_class_type)rt_object_get_type(object));
+    hash = _object_hash(object->name);
+#endif
+
     /* reset object type */
     object->type = 0;
 
@@ -318,6 +417,10 @@ void rt_object_detach(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    if (information != RT_NULL)
+        _object_hash_remove(information, object, hash);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -337,6 +440,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     struct rt_object *object;
     register rt_base_t temp;
     struct rt_object_information *information;
+#ifdef RT_USING_OBJECT_HASH
+    rt_uint32_t hash;
+#endif
 #ifdef RT_USING_MODULE
     struct rt_dlmodule *module = dlmodule_self();
 #endif
@@ -367,6 +473,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
 
     /* copy name */
     rt_strncpy(object->name, name, RT_NAME_MAX);
+#ifdef RT_USING_OBJECT_HASH
+    hash = _object_hash(object->name);
+#endif
 
     RT_OBJECT_HOOK_CALL(rt_object_attach_hook, (object));
 
@@ -384,6 +493,11 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        /* and into its name bucket, the newest first as in the list */
+        object->hash_next = information->hash[hash];
+        information->hash[hash] = object;
+#endif
     }
 
     /* unlock interrupt */
@@ -401,6 +515,10 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
 void rt_object_delete(rt_object_t object)
 {
     register rt_base_t temp;
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object_information *information;
+    rt_uint32_t hash;
+#endif
 
     /* object check */
     RT_ASSERT(object != RT_NULL);
@@ -408,6 +526,11 @@ void rt_object_delete(rt_object_t object)
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
+#ifdef RT_USING_OBJECT_HASH
+    information = rt_object_get_information((enum rt_object_class_type)rt_object_get_type(object));
+    hash = _object_hash(object->name);
+#endif
+
     /* reset object type */
     object->type = 0;
 
@@ -416,6 +539,10 @@ void rt_object_delete(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    if (information != RT_NULL)
+        _object_hash_remove(information, object, hash);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -476,7 +603,9 @@ rt_uint8_t rt_object_get_type(rt_object_t object)
 rt_object_t rt_object_find(const char *name, rt_uint8_t type)
 {
     struct rt_object *object = RT_NULL;
+#ifndef RT_USING_OBJECT_HASH
     struct rt_list_node *node = RT_NULL;
+#endif
     struct rt_object_information *information = RT_NULL;
 
     /* parameter check */
@@ -486,6 +615,27 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     /* which is invoke in interrupt status */
     RT_DEBUG_NOT_IN_INTERRUPT;
 
+#ifdef RT_USING_OBJECT_HASH
+    information = rt_object_get_information((enum rt_object_class_type)type);
+    RT_ASSERT(information != RT_NULL);
+
+    /* enter critical */
+    rt_enter_critical();
+
+    /* only the objects in the bucket of name */
+    for (object  = information->hash[_object_hash(name)];
+         object != RT_NULL;
+         object  = object->hash_next)
+    {
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+            break;
+    }
+
+    /* leave critical */
+    rt_exit_critical();
+
+    return object;
+#else
     /* enter critical */
     rt_enter_critical();
 
@@ -513,6 +663,7 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     rt_exit_critical();
 
     return RT_NULL;
+#endif
 }
 
 /**@}*/
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ * 2026-10-19     tangmenglin  harmonic with all tasks of group, wake up at
+ *                             the earliest release.
+ */
+
+/*
+ * Periodic tasks in rate groups.
+ *
+ * A periodic task is a callback with a period and an offset, defined by
+ * RT_PERIODIC_TASK_DEFINE in the rt_periodic_task section. At boot the tasks
+ * are merged into rate groups: a task joins a group if its period is a
+ * multiple or a divisor of the period of each task in the group. Each group
+ * is one thread, which sleeps until the earliest release tick of its tasks
+ * and calls the tasks released, so the releases do not drift as a delay
+ * loop does. The group of shorter base period has the higher priority,
+ * counted from RT_PERIODIC_PRIORITY.
+ *
+ * For each task, the cycles of each call and the cycles between two starts
+ * are recorded. The range of the latter is the jitter of task. A task
+ * overruns if it returns after its next release.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_PERIODIC
+
+#ifndef RT_PERIODIC_GROUP_MAX
+#define RT_PERIODIC_GROUP_MAX       2
+#endif
+
+#ifndef RT_PERIODIC_PRIORITY
+#define RT_PERIODIC_PRIORITY        10
+#endif
+
+#ifndef RT_PERIODIC_STACK_SIZE
+#define RT_PERIODIC_STACK_SIZE      1024
+#endif
+
+struct rt_periodic_group
+{
+    struct rt_thread thread;
+    rt_tick_t base;                                     /* the shortest period */
+    int nr_tasks;
+    struct rt_periodic_task *tasks;
+};
+
+/* the tasks, defined by linker for the section */
+extern struct rt_periodic_task __start_rt_periodic_task[];
+extern struct rt_periodic_task __stop_rt_periodic_task[];
+
+static struct rt_periodic_group _periodic_group[RT_PERIODIC_GROUP_MAX];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _periodic_stack[RT_PERIODIC_GROUP_MAX][RT_PERIODIC_STACK_SIZE];
+static int _periodic_nr_groups;
+static rt_tick_t _periodic_epoch;
+
+static void _rt_periodic_task_run(struct rt_periodic_task *task)
+{
+    rt_uint32_t start, cycles;
+
+    start = rt_hw_cycle_get();
+    if (task->runs != 0)
+    {
+        cycles = start - task->last_start;
+        if (cycles < task->interval_min)
+            task->interval_min = cycles;
+        if (cycles > task->interval_max)
+            task->interval_max = cycles;
+    }
+    task->last_start = start;
+
+    task->callback(task->parameter);
+
+    cycles = rt_hw_cycle_get() - start;
+    if (cycles < task->exec_min)
+        task->exec_min = cycles;
+    if (cycles > task->exec_max)
+        task->exec_max = cycles;
+    task->runs ++;
+
+    /* the next release is passed */
+    task->release += task->period;
+    if ((rt_int32_t)(rt_tick_get() - task->release) >= 0)
+        task->overruns ++;
+}
+
+static void _rt_periodic_group_entry(void *parameter)
+{
+    struct rt_periodic_group *group = (struct rt_periodic_group *)parameter;
+    struct rt_periodic_task *task;
+    rt_tick_t release, now;
+
+    while (1)
+    {
+        /* the earliest release of tasks */
+        release = group->tasks->release;
+        for (task = group->tasks->next; task != RT_NULL; task = task->next)
+        {
+            if ((rt_int32_t)(task->release - release) < 0)
+                release = task->release;
+        }
+
+        now = rt_tick_get();
+        if ((rt_int32_t)(release - now) > 0)
+            rt_thread_delay(release - now);
+
+        /* the tasks released, and those late after an overrun */
+        now = rt_tick_get();
+        for (task = group->tasks; task != RT_NULL; task = task->next)
+        {
+            if ((rt_int32_t)(now - task->release) >= 0)
+                _rt_periodic_task_run(task);
+        }
+    }
+}
+
+/* whether the period of task is harmonic with the periods of all tasks in group */
+static rt_bool_t _rt_periodic_group_harmonic(struct rt_periodic_group *group,
+                                             struct rt_periodic_task *task)
+{
+    struct rt_periodic_task *member;
+
+    for (member = group->tasks; member != RT_NULL; member = member->next)
+    {
+        if (task->period % member->period != 0 && member->period % task->period != 0)
+            return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
+/* it adds a task to the group of harmonic periods */
+static rt_err_t _rt_periodic_group_add(struct rt_periodic_task *task)
+{
+    struct rt_periodic_group *group;
+    int index;
+
+    for (index = 0; index < _periodic_nr_groups; index++)
+    {
+        group = &_periodic_group[index];
+        if (_rt_periodic_group_harmonic(group, task))
+            break;
+    }
+
+    if (index == _periodic_nr_groups)
+    {
+        if (_periodic_nr_groups == RT_PERIODIC_GROUP_MAX)
+            return -RT_EFULL;
+
+        group = &_periodic_group[_periodic_nr_groups ++];
+        group->base     = task->period;
+        group->nr_tasks = 0;
+        group->tasks    = RT_NULL;
+    }
+
+    if (task->period < group->base)
+        group->base = task->period;
+    group->nr_tasks ++;
+
+    task->next   = group->tasks;
+    group->tasks = task;
+
+    return RT_EOK;
+}
+
+/**
+ * @addtogroup Thread
+ */
+
+/**@{*/
+
+/**
+ * This function will merge the periodic tasks into rate groups and start
+ * the threads of groups. It is invoked at boot by components initialization.
+ *
+ * @return RT_EOK, -RT_EFULL if the tasks need more than RT_PERIODIC_GROUP_MAX
+ *         groups, the tasks of other groups are not started
+ */
+int rt_periodic_init(void)
+{
+    struct rt_periodic_task *task;
+    struct rt_periodic_group *group;
+    rt_err_t result = RT_EOK;
+    char name[RT_NAME_MAX];
+    int index, rank, other;
+
+    _periodic_epoch = rt_tick_get() + 1;
+
+    for (task = __start_rt_periodic_task; task < __stop_rt_periodic_task; task++)
+    {
+        RT_ASSERT(task->period != 0);
+        RT_ASSERT(task->callback != RT_NULL);
+
+        task->release      = _periodic_epoch + task->offset;
+        task->exec_min     = ~0u;
+        task->exec_max     = 0;
+        task->interval_min = ~0u;
+        task->interval_max = 0;
+        task->runs         = 0;
+        task->overruns     = 0;
+
+        if (_rt_periodic_group_add(task) != RT_EOK)
+        {
+            rt_kprintf("periodic task %s: no rate group left\n", task->name);
+            result = -RT_EFULL;
+        }
+    }
+
+    for (index = 0; index < _periodic_nr_groups; index++)
+    {
+        group = &_periodic_group[index];
+
+        /* rate monotonic, the shorter base period the higher priority */
+        rank = 0;
+        for (other = 0; other < _periodic_nr_groups; other++)
+        {
+            if (_periodic_group[other].base < group->base ||
+                (_periodic_group[other].base == group->base && other < index))
+                rank ++;
+        }
+
+        /* numbered by index, the base period may not fit in RT_NAME_MAX */
+        rt_snprintf(name, sizeof(name), "rate%d", index);
+        rt_thread_init(&group->thread, name, _rt_periodic_group_entry, group,
+                       _periodic_stack[index], RT_PERIODIC_STACK_SIZE,
+                       RT_PERIODIC_PRIORITY + rank, 10);
+        rt_thread_startup(&group->thread);
+    }
+
+    return result;
+}
+INIT_APP_EXPORT(rt_periodic_init);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+int list_periodic(void)
+{
+    struct rt_periodic_task *task;
+    int index;
+
+    rt_kprintf("group    base task pri\n");
+    rt_kprintf("-------- ---- ---- ---\n");
+    for (index = 0; index < _periodic_nr_groups; index++)
+    {
+        rt_kprintf("%-8.*s %4d %4d %3d\n", RT_NAME_MAX, _periodic_group[index].thread.name,
+                   _periodic_group[index].base, _periodic_group[index].nr_tasks,
+                   _periodic_group[index].thread.current_priority);
+    }
+
+    rt_kprintf("\ntask             period offset     runs exec max   jitter overrun\n");
+    rt_kprintf("---------------- ------ ------ -------- -------- -------- -------\n");
+    for (task = __start_rt_periodic_task; task < __stop_rt_periodic_task; task++)
+    {
+        rt_kprintf("%-16s %6d %6d %8d %8d %8d %7d\n", task->name,
+                   task->period, task->offset, task->runs, task->exec_max,
+                   task->runs > 1 ? task->interval_max - task->interval_min : 0,
+                   task->overruns);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_periodic, list periodic tasks and rate groups);
+#endif /* end of RT_USING_FINSH */
+
+#endif /* end of RT_USING_PERIODIC */
@@ -21,6 +21,14 @@
  * 2010-12-13     Bernard      add defunct list initialization even if not use heap.
  * 2011-05-10     Bernard      clean scheduler debug log.
  * 2013-12-21     Grissiom     add rt_critical_level
+ * 2026-10-19     tangmenglin  add EDF band ordered by absolute deadline
+ * 2026-10-19     tangmenglin  add preemption threshold of the running thread
+ * 2026-10-19     tangmenglin  add directed handoff to the thread woken by IPC
+ * 2026-10-19     tangmenglin  ready table of 8 words for 256 priorities, one
+ *                             __rt_ffs on each level
+ * 2026-10-19     tangmenglin  record wakeup-to-run latency of threads
+ * 2026-10-19     tangmenglin  profile the sections with scheduler locked
+ * 2026-10-19     tangmenglin  donate the longer of both timeslices in handoff
  */
 
 #include <rtthread.h>
@@ -35,9 +43,12 @@ struct rt_thread *rt_current_thread;
 rt_uint8_t rt_current_priority;
 
 #if RT_THREAD_PRIORITY_MAX > 32
-/* Maximum priority level, 256 */
+/*
+ * Maximum priority level, 256. The group has a bit for each word of the ready
+ * table, and each word has a bit for each of 32 priorities.
+ */
 rt_uint32_t rt_thread_ready_priority_group;
-rt_uint8_t rt_thread_ready_table[32];
+rt_uint32_t rt_thread_ready_table[8];
 #else
 /* Maximum priority level, 32 */
 rt_uint32_t rt_thread_ready_priority_group;
@@ -111,6 +122,35 @@ static void _rt_scheduler_stack_check(struct rt_thread *thread)
 }
 #endif
 
+#ifdef RT_USING_SCHED_EDF
+/*
+ * The ready list of EDF band is ordered by absolute deadline, the earliest
+ * first, so rt_schedule picks the earliest deadline when the band is the
+ * highest ready priority. A thread out of EDF band at this level goes after
+ * all of EDF threads, and a thread goes after the ones with the same
+ * deadline, so they still share the processor by time slice.
+ */
+static void _rt_schedule_edf_insert(struct rt_thread *thread)
+{
+    rt_list_t *head = &(rt_thread_priority_table[RT_SCHED_EDF_PRIORITY]);
+    rt_list_t *node = head;
+    struct rt_thread *next;
+
+    if (thread->edf_period != 0)
+    {
+        for (node = head->next; node != head; node = node->next)
+        {
+            next = rt_list_entry(node, struct rt_thread, tlist);
+            if (next->edf_period == 0 ||
+                (rt_int32_t)(thread->edf_deadline - next->edf_deadline) < 0)
+                break;
+        }
+    }
+
+    rt_list_insert_before(node, &(thread->tlist));
+}
+#endif
+
 /**
  * @ingroup SystemInit
  * This function will initialize the system scheduler
@@ -158,7 +198,7 @@ void rt_system_scheduler_start(void)
     register rt_ubase_t number;
 
     number = __rt_ffs(rt_thread_ready_priority_group) - 1;
-    highest_ready_priority = (number << 3) + __rt_ffs(rt_thread_ready_table[number]) - 1;
+    highest_ready_priority = (number << 5) + __rt_ffs(rt_thread_ready_table[number]) - 1;
 #else
     highest_ready_priority = __rt_ffs(rt_thread_ready_priority_group) - 1;
 #endif
@@ -206,7 +246,26 @@ void rt_schedule(void)
         register rt_ubase_t number;
 
         number = __rt_ffs(rt_thread_ready_priority_group) - 1;
-        highest_ready_priority = (number << 3) + __rt_ffs(rt_thread_ready_table[number]) - 1;
+        highest_ready_priority = (number << 5) + __rt_ffs(rt_thread_ready_table[number]) - 1;
+#endif
+
+#ifdef RT_USING_PREEMPT_THRESHOLD
+        /*
+         * the running thread keeps CPU if the higher priority is not above
+         * its threshold. It still yields to the threads of same priority,
+         * and a thread out of CPU budget has no threshold.
+         */
+        if ((rt_current_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_READY &&
+#ifdef RT_USING_THREAD_BUDGET
+            !rt_current_thread->budget_throttled &&
+#endif
+            highest_ready_priority <  rt_current_thread->current_priority &&
+            highest_ready_priority >= rt_current_thread->preempt_threshold)
+        {
+            rt_hw_interrupt_enable(level);
+
+            return;
+        }
 #endif
 
         /* get switch to thread */
@@ -223,6 +282,10 @@ void rt_schedule(void)
 
             RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (from_thread, to_thread));
 
+#ifdef RT_USING_LATENCY
+            rt_latency_switch(from_thread, to_thread);
+#endif
+
             /* switch to new thread */
             RT_DEBUG_LOG(RT_DEBUG_SCHEDULER,
                          ("[%d]switch to priority#%d "
@@ -276,6 +339,94 @@ void rt_schedule(void)
     rt_hw_interrupt_enable(level);
 }
 
+#ifdef RT_USING_IPC_HANDOFF
+/*
+ * This function will resume a thread suspended on IPC object, and switch to
+ * it directly when it is sure to be the next thread: no ready thread is above
+ * it and it is the first one of its priority, and neither the running thread
+ * nor the scheduler lock or interrupt keeps CPU. Otherwise it is the same as
+ * rt_thread_resume and rt_schedule.
+ *
+ * @param thread the thread to be resumed
+ * @param level the interrupt level returned by rt_hw_interrupt_disable,
+ *        the interrupt is enabled with it on return
+ *
+ * @note Please do not invoke this function in user application.
+ */
+void rt_schedule_handoff(struct rt_thread *thread, rt_base_t level)
+{
+    struct rt_thread *from_thread;
+
+    rt_thread_resume(thread);
+
+    if (rt_scheduler_lock_nest != 0 || rt_interrupt_nest != 0 ||
+        thread->current_priority >= rt_current_thread->current_priority ||
+#ifdef RT_USING_PREEMPT_THRESHOLD
+        thread->current_priority >= rt_current_thread->preempt_threshold ||
+#endif
+        (rt_thread_ready_priority_group & (thread->number_mask - 1)) ||
+#if RT_THREAD_PRIORITY_MAX > 32
+        (rt_thread_ready_table[thread->number] & (thread->high_mask - 1)) ||
+#endif
+        rt_thread_priority_table[thread->current_priority].next != &(thread->tlist))
+    {
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return;
+    }
+
+    from_thread         = rt_current_thread;
+    rt_current_priority = thread->current_priority;
+    rt_current_thread   = thread;
+
+#ifdef RT_IPC_HANDOFF_DONATE
+    /* the woken thread runs on the rest of timeslice, if it is longer */
+    if (thread->remaining_tick < from_thread->remaining_tick)
+        thread->remaining_tick = from_thread->remaining_tick;
+#endif
+
+    RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (from_thread, thread));
+
+#ifdef RT_USING_LATENCY
+    rt_latency_switch(from_thread, thread);
+#endif
+
+    RT_DEBUG_LOG(RT_DEBUG_SCHEDULER,
+                 ("handoff to priority#%d thread:%.*s(sp:0x%p), "
+                  "from thread:%.*s(sp: 0x%p)\n",
+                  thread->current_priority,
+                  RT_NAME_MAX, thread->name, thread->sp,
+                  RT_NAME_MAX, from_thread->name, from_thread->sp));
+
+#ifdef RT_USING_OVERFLOW_CHECK
+    _rt_scheduler_stack_check(thread);
+#endif
+
+    rt_hw_context_switch((rt_uint32_t)&from_thread->sp,
+                         (rt_uint32_t)&thread->sp);
+
+#ifdef RT_USING_SIGNALS
+    if (rt_current_thread->stat & RT_THREAD_STAT_SIGNAL_PENDING)
+    {
+        extern void rt_thread_handle_sig(rt_bool_t clean_state);
+
+        rt_current_thread->stat &= ~RT_THREAD_STAT_SIGNAL_PENDING;
+
+        rt_hw_interrupt_enable(level);
+
+        /* check signal status */
+        rt_thread_handle_sig(RT_TRUE);
+
+        return;
+    }
+#endif
+
+    rt_hw_interrupt_enable(level);
+}
+#endif
+
 /*
  * This function will insert a thread to system ready queue. The state of
  * thread will be set as READY and remove from suspend queue.
@@ -292,12 +443,27 @@ void rt_schedule_insert_thread(struct rt_thread *thread)
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_LATENCY
+    /* a ready thread only changes its priority */
+    if ((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_READY)
+        rt_latency_ready(thread);
+#endif
+
     /* change stat */
     thread->stat = RT_THREAD_READY | (thread->stat & ~RT_THREAD_STAT_MASK);
 
     /* insert thread to ready list */
-    rt_list_insert_before(&(rt_thread_priority_table[thread->current_priority]),
-                          &(thread->tlist));
+#ifdef RT_USING_SCHED_EDF
+    if (thread->current_priority == RT_SCHED_EDF_PRIORITY)
+    {
+        _rt_schedule_edf_insert(thread);
+    }
+    else
+#endif
+    {
+        rt_list_insert_before(&(rt_thread_priority_table[thread->current_priority]),
+                              &(thread->tlist));
+    }
 
     /* set priority mask */
 #if RT_THREAD_PRIORITY_MAX <= 32
@@ -387,6 +553,11 @@ void rt_enter_critical(void)
      */
     rt_scheduler_lock_nest ++;
 
+#ifdef RT_USING_IRQOFF_PROFILE
+    if (rt_scheduler_lock_nest == 1)
+        rt_irqoff_lock_enter((rt_ubase_t)__builtin_return_address(0));
+#endif
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 }
@@ -406,6 +577,9 @@ void rt_exit_critical(void)
     if (rt_scheduler_lock_nest <= 0)
     {
         rt_scheduler_lock_nest = 0;
+#ifdef RT_USING_IRQOFF_PROFILE
+        rt_irqoff_lock_leave();
+#endif
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
 
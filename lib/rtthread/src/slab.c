@@ -13,6 +13,10 @@
  * 2010-07-13     Bernard      fix RT_ALIGN issue found by kuronca
  * 2010-10-23     yi.qiu       add module memory allocator
  * 2010-12-18     yi.qiu       fix zone release bug
+ * 2026-10-19     tangmenglin  add memory pressure check and reclaim retry
+ * 2026-10-19     tangmenglin  replace the page list with a binary buddy allocator
+ * 2026-10-19     tangmenglin  constant time buddy lookup with a bitmap of free blocks
+ * 2026-10-19     tangmenglin  bound the reclaim retries
  */
 
 /*
@@ -221,48 +225,242 @@ static struct memusage *memusage = RT_NULL;
 
 static rt_uint32_t heap_start, heap_end;
 
-/* page allocator */
+/*
+ * page allocator
+ *
+ * A binary buddy allocator. A free block of 2^order pages starts on a page
+ * index which is a multiple of 2^order (relative to heap_start), and its
+ * buddy is found by flipping bit 'order' of the page index. There is a free
+ * list for each order, a mask of the non-empty lists, and a bitmap with a
+ * bit for each page which heads a free block, whose order is kept in the
+ * block itself. So the smallest free block which fits is found, and the
+ * buddy of a released block is checked and taken from its list, in constant
+ * time; an allocation or a release splits or merges at most
+ * RT_PAGE_MAX_ORDER times.
+ *
+ * Requests that are not a power of two are carved from the next order, and
+ * the unused tail pages are given back at once, so that rt_page_free() with
+ * the same page count releases exactly what was allocated.
+ *
+ * When no block of the required order is free, the bitmap is walked for a
+ * run of adjacent free blocks before the request fails, so that a request is
+ * never refused while the pages are free but not buddies of each other.
+ * The bitmap lives in the first heap pages.
+ */
+#ifndef RT_PAGE_MAX_ORDER
+#define RT_PAGE_MAX_ORDER   16
+#endif
+
 struct rt_page_head
 {
-    struct rt_page_head *next;      /* next valid page */
-    rt_size_t page;                 /* number of page  */
+    struct rt_page_head *next;      /* next free block of the same order */
+    struct rt_page_head *prev;      /* prev free block of the same order */
+    rt_uint32_t order;              /* order of the free block */
 
     /* dummy */
-    char dummy[RT_MM_PAGE_SIZE - (sizeof(struct rt_page_head *) + sizeof(rt_size_t))];
+    char dummy[RT_MM_PAGE_SIZE - (sizeof(struct rt_page_head *) * 2 + sizeof(rt_uint32_t))];
 };
-static struct rt_page_head *rt_page_list;
+static struct rt_page_head *rt_page_list[RT_PAGE_MAX_ORDER];
+static rt_uint32_t rt_page_orders;      /* bit n is set if list n is not empty */
+static rt_uint32_t *rt_page_bitmap;     /* bit n is set if page n heads a free block */
+static rt_size_t rt_page_count;
 static struct rt_semaphore heap_sem;
 
+#ifdef RT_MEM_STATS
+static rt_size_t page_free_cnt;
+#endif
+
+#define page_index(addr)    (((rt_uint32_t)(addr) - heap_start) >> RT_MM_PAGE_BITS)
+#define page_addr(index)    ((struct rt_page_head *)(heap_start + ((index) << RT_MM_PAGE_BITS)))
+#define page_is_free(index) (rt_page_bitmap[(index) >> 5] & (1UL << ((index) & 31)))
+
+/*
+ * the block goes to the head of list, or right after the head if that one
+ * is lower, so the lower of them is used first without a walk of the list
+ */
+rt_inline void _page_list_insert(rt_size_t index, rt_uint32_t order)
+{
+    struct rt_page_head *b = page_addr(index);
+    struct rt_page_head *h = rt_page_list[order];
+
+    b->order = order;
+    if (h != RT_NULL && h < b)
+    {
+        b->prev = h;
+        b->next = h->next;
+        h->next = b;
+    }
+    else
+    {
+        b->prev = RT_NULL;
+        b->next = h;
+        rt_page_list[order] = b;
+    }
+    if (b->next != RT_NULL)
+        b->next->prev = b;
+
+    rt_page_orders |= 1UL << order;
+    rt_page_bitmap[index >> 5] |= 1UL << (index & 31);
+}
+
+rt_inline void _page_list_remove(struct rt_page_head *b, rt_uint32_t order)
+{
+    rt_size_t index = page_index(b);
+
+    if (b->prev != RT_NULL)
+        b->prev->next = b->next;
+    else if ((rt_page_list[order] = b->next) == RT_NULL)
+        rt_page_orders &= ~(1UL << order);
+    if (b->next != RT_NULL)
+        b->next->prev = b->prev;
+
+    rt_page_bitmap[index >> 5] &= ~(1UL << (index & 31));
+}
+
+/* release one aligned block of 2^order pages and merge it with its buddies */
+static void _page_free_block(rt_size_t index, rt_uint32_t order)
+{
+    rt_size_t buddy;
+
+    while (order < RT_PAGE_MAX_ORDER - 1)
+    {
+        buddy = index ^ (1UL << order);
+        if (buddy >= rt_page_count || !page_is_free(buddy) ||
+            page_addr(buddy)->order != order)
+            break;
+
+        /* buddy is free, merge them */
+        _page_list_remove(page_addr(buddy), order);
+        index &= ~(1UL << order);
+        order ++;
+    }
+
+    _page_list_insert(index, order);
+}
+
+/* release a range of pages, which is split to aligned power-of-2 blocks */
+static void _page_free_range(rt_size_t index, rt_size_t npages)
+{
+    rt_uint32_t order;
+
+#ifdef RT_MEM_STATS
+    page_free_cnt += npages;
+#endif
+
+    while (npages)
+    {
+        /* the largest aligned block which starts from index and fits in range */
+        for (order = 0; order < RT_PAGE_MAX_ORDER - 1; order ++)
+        {
+            if ((index & (1UL << order)) || (2UL << order) > npages)
+                break;
+        }
+
+        _page_free_block(index, order);
+
+        index  += 1UL << order;
+        npages -= 1UL << order;
+    }
+}
+
+/*
+ * find a run of adjacent free blocks which holds npages, it walks the
+ * bitmap and is only tried when no free block of the order is left
+ */
+static struct rt_page_head *_page_alloc_run(rt_size_t npages)
+{
+    rt_size_t index, start = 0, run = 0;
+    rt_uint32_t order, bits;
+
+    for (index = 0; index < rt_page_count && run < npages;)
+    {
+        if (!page_is_free(index))
+        {
+            /* skip to the next free block in bitmap */
+            run  = 0;
+            bits = rt_page_bitmap[index >> 5] >> (index & 31);
+            index = bits ? index + __builtin_ctz(bits) : (index | 31) + 1;
+            continue;
+        }
+
+        if (run == 0)
+            start = index;
+        run   += 1UL << page_addr(index)->order;
+        index += 1UL << page_addr(index)->order;
+    }
+    if (run < npages)
+        return RT_NULL;
+
+    /* take the free blocks of this run */
+    for (index = start; index < start + npages;)
+    {
+        order = page_addr(index)->order;
+        _page_list_remove(page_addr(index), order);
+        index += 1UL << order;
+    }
+
+#ifdef RT_MEM_STATS
+    page_free_cnt -= index - start;
+#endif
+
+    /* give back the pages beyond request */
+    if (index > start + npages)
+        _page_free_range(start + npages, index - start - npages);
+
+    return page_addr(start);
+}
+
 void *rt_page_alloc(rt_size_t npages)
 {
-    struct rt_page_head *b, *n;
-    struct rt_page_head **prev;
+    struct rt_page_head *b;
+    rt_uint32_t order, n;
+    rt_size_t index;
 
     if (npages == 0)
         return RT_NULL;
 
+    if (npages > rt_page_count)
+        return RT_NULL;
+
+    /* round up to the order of buddy block */
+    for (order = 0; (1UL << order) < npages; order ++) ;
+    if (order >= RT_PAGE_MAX_ORDER)
+        return RT_NULL;
+
     /* lock heap */
     rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
-    for (prev = &rt_page_list; (b = *prev) != RT_NULL; prev = &(b->next))
+
+    /* find the smallest free block which fits */
+    if ((rt_page_orders >> order) == 0)
     {
-        if (b->page > npages)
-        {
-            /* splite pages */
-            n       = b + npages;
-            n->next = b->next;
-            n->page = b->page - npages;
-            *prev   = n;
-            break;
-        }
+        b = _page_alloc_run(npages);
 
-        if (b->page == npages)
-        {
-            /* this node fit, remove this node */
-            *prev = b->next;
-            break;
-        }
+        /* unlock heap */
+        rt_sem_release(&heap_sem);
+
+        return b;
+    }
+    n = order + __builtin_ctz(rt_page_orders >> order);
+
+    b = rt_page_list[n];
+    _page_list_remove(b, n);
+    index = page_index(b);
+
+    /* split block, put the upper halves back */
+    while (n > order)
+    {
+        n --;
+        _page_list_insert(index + (1UL << n), n);
     }
 
+#ifdef RT_MEM_STATS
+    page_free_cnt -= 1UL << order;
+#endif
+
+    /* give back the unused tail pages */
+    if ((1UL << order) > npages)
+        _page_free_range(index + npages, (1UL << order) - npages);
+
     /* unlock heap */
     rt_sem_release(&heap_sem);
 
@@ -271,66 +469,87 @@ void *rt_page_alloc(rt_size_t npages)
 
 void rt_page_free(void *addr, rt_size_t npages)
 {
-    struct rt_page_head *b, *n;
-    struct rt_page_head **prev;
-
     RT_ASSERT(addr != RT_NULL);
     RT_ASSERT((rt_uint32_t)addr % RT_MM_PAGE_SIZE == 0);
     RT_ASSERT(npages != 0);
-
-    n = (struct rt_page_head *)addr;
+    RT_ASSERT(page_index(addr) + npages <= rt_page_count);
 
     /* lock heap */
     rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
 
-    for (prev = &rt_page_list; (b = *prev) != RT_NULL; prev = &(b->next))
-    {
-        RT_ASSERT(b->page > 0);
-        RT_ASSERT(b > n || b + b->page <= n);
+    _page_free_range(page_index(addr), npages);
 
-        if (b + b->page == n)
-        {
-            if (b + (b->page += npages) == b->next)
-            {
-                b->page += b->next->page;
-                b->next  = b->next->next;
-            }
+    /* unlock heap */
+    rt_sem_release(&heap_sem);
+}
 
-            goto _return;
-        }
+#ifdef RT_MEM_STATS
+/**
+ * This function will return the page usage of page allocator.
+ *
+ * @param total the total pages of page allocator
+ * @param free the free pages
+ * @param max_free the pages of the largest run of free pages
+ */
+void rt_page_info(rt_uint32_t *total,
+                  rt_uint32_t *free,
+                  rt_uint32_t *max_free)
+{
+    rt_size_t index, run;
 
-        if (b == n + npages)
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+    if (total != RT_NULL)
+        *total = rt_page_count;
+    if (free != RT_NULL)
+        *free = page_free_cnt;
+    if (max_free != RT_NULL)
+    {
+        *max_free = 0;
+        for (index = 0, run = 0; index < rt_page_count;)
         {
-            n->page = b->page + npages;
-            n->next = b->next;
-            *prev   = n;
+            if (!page_is_free(index))
+            {
+                run = 0;
+                index ++;
+                continue;
+            }
 
-            goto _return;
+            run   += 1UL << page_addr(index)->order;
+            index += 1UL << page_addr(index)->order;
+            if (run > *max_free)
+                *max_free = run;
         }
-
-        if (b > n + npages)
-            break;
     }
-
-    n->page = npages;
-    n->next = b;
-    *prev   = n;
-
-_return:
-    /* unlock heap */
     rt_sem_release(&heap_sem);
 }
+#endif
 
 /*
  * Initialize the page allocator
  */
 static void rt_page_init(void *addr, rt_size_t npages)
 {
+    rt_size_t index, meta_pages;
+
     RT_ASSERT(addr != RT_NULL);
     RT_ASSERT(npages != 0);
 
-    rt_page_list = RT_NULL;
-    rt_page_free(addr, npages);
+    /* the bitmap of free blocks is placed at the beginning pages */
+    meta_pages = RT_ALIGN((npages + 31) / 32 * sizeof(rt_uint32_t), RT_MM_PAGE_SIZE) /
+                 RT_MM_PAGE_SIZE;
+    RT_ASSERT(meta_pages < npages);
+
+    rt_page_bitmap = (rt_uint32_t *)addr;
+    rt_page_count  = npages;
+    rt_memset(rt_page_bitmap, 0, meta_pages * RT_MM_PAGE_SIZE);
+    for (index = 0; index < RT_PAGE_MAX_ORDER; index ++)
+        rt_page_list[index] = RT_NULL;
+    rt_page_orders = 0;
+
+#ifdef RT_MEM_STATS
+    page_free_cnt = 0;
+#endif
+    _page_free_range(meta_pages, npages - meta_pages);
 }
 
 /**
@@ -364,6 +583,9 @@ void rt_system_heap_init(void *begin_addr, void *end_addr)
 
     /* initialize heap semaphore */
     rt_sem_init(&heap_sem, "heap", 1, RT_IPC_FLAG_FIFO);
+#ifdef RT_USING_MEMPRESSURE
+    rt_mem_reclaim_init();
+#endif
 
     RT_DEBUG_LOG(RT_DEBUG_SLAB, ("heap[0x%x - 0x%x], size 0x%x, 0x%x pages\n",
                                  heap_start, heap_end, limsize, npages));
@@ -481,11 +703,17 @@ void *rt_malloc(rt_size_t size)
     rt_int32_t zi;
     slab_chunk *chunk;
     struct memusage *kup;
+#ifdef RT_USING_MEMPRESSURE
+    rt_uint8_t reclaim_pass = 0;
+#endif
 
     /* zero size, return RT_NULL */
     if (size == 0)
         return RT_NULL;
 
+#ifdef RT_USING_MEMPRESSURE
+__retry:
+#endif
     /*
      * Handle large allocations directly.  There should not be very many of
      * these so performance is not a big issue.
@@ -496,7 +724,7 @@ void *rt_malloc(rt_size_t size)
 
         chunk = rt_page_alloc(size >> RT_MM_PAGE_BITS);
         if (chunk == RT_NULL)
-            return RT_NULL;
+            goto __exit;
 
         /* set kup */
         kup = btokup(chunk);
@@ -662,7 +890,18 @@ done:
     rt_sem_release(&heap_sem);
     RT_OBJECT_HOOK_CALL(rt_malloc_hook, ((char *)chunk, size));
 
+#ifdef RT_USING_MEMPRESSURE
+    rt_mem_pressure_check(heap_end - heap_start, used_mem);
+#endif
+
 __exit:
+#ifdef RT_USING_MEMPRESSURE
+    /* let the reclaim callbacks release memory, then try again */
+    if (chunk == RT_NULL && reclaim_pass ++ < RT_MEM_RECLAIM_RETRY &&
+        rt_mem_reclaim(size) > 0)
+        goto __retry;
+#endif
+
     return chunk;
 }
 RTM_EXPORT(rt_malloc);
@@ -816,6 +1055,10 @@ void rt_free(void *ptr)
         /* free this page */
         rt_page_free(ptr, size);
 
+#ifdef RT_USING_MEMPRESSURE
+        rt_mem_pressure_check(heap_end - heap_start, used_mem);
+#endif
+
         return;
     }
 
@@ -896,11 +1139,19 @@ void rt_free(void *ptr)
             /* release pages */
             rt_page_free(z, zone_size / RT_MM_PAGE_SIZE);
 
+#ifdef RT_USING_MEMPRESSURE
+            rt_mem_pressure_check(heap_end - heap_start, used_mem);
+#endif
+
             return;
         }
     }
     /* unlock heap */
     rt_sem_release(&heap_sem);
+
+#ifdef RT_USING_MEMPRESSURE
+    rt_mem_pressure_check(heap_end - heap_start, used_mem);
+#endif
 }
 RTM_EXPORT(rt_free);
 
@@ -24,6 +24,14 @@
  * 2016-08-09     ArdaFu       add thread suspend and resume hook.
  * 2017-04-10     armink       fixed the rt_thread_delete and rt_thread_detach
                                bug when thread has not startup.
+ * 2026-10-19     tangmenglin  initialize heap accounting slot of thread.
+ * 2026-10-19     tangmenglin  find thread by rt_object_find.
+ * 2026-10-19     tangmenglin  add EDF parameters and rt_thread_edf_wait.
+ * 2026-10-19     tangmenglin  add CPU budget of thread.
+ * 2026-10-19     tangmenglin  add preemption threshold of thread.
+ * 2026-10-19     tangmenglin  ready table of 32-bit words for 256 priorities.
+ * 2026-10-19     tangmenglin  clear latency histogram of thread.
+ * 2026-10-19     tangmenglin  restore fixed priority of thread leaving EDF.
  */
 
 #include <rtthread.h>
@@ -78,6 +86,194 @@ void rt_thread_inited_sethook(void (*hook)(rt_thread_t thread))
 
 #endif
 
+#ifdef RT_USING_SCHED_EDF
+/* the density admitted in EDF band, in 1/1000 */
+static rt_uint32_t _edf_density_total;
+
+/* runtime over the shorter of deadline and period, rounded up */
+static rt_uint32_t _rt_thread_edf_density(rt_tick_t runtime, rt_tick_t deadline, rt_tick_t period)
+{
+    rt_tick_t span = deadline < period ? deadline : period;
+
+    return (runtime * 1000 + span - 1) / span;
+}
+
+static void _rt_thread_edf_leave(struct rt_thread *thread)
+{
+    register rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (thread->edf_period != 0)
+    {
+        _edf_density_total -= _rt_thread_edf_density(thread->edf_runtime,
+                                                     thread->edf_rel_deadline,
+                                                     thread->edf_period);
+        thread->edf_period = 0;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/*
+ * Admission control: the densities of EDF threads shall not exceed
+ * RT_SCHED_EDF_UTILIZATION, which is enough for EDF to meet all of deadlines
+ * if the band is not preempted by higher priorities.
+ */
+static rt_err_t _rt_thread_edf_set(struct rt_thread *thread, struct rt_thread_edf *edf)
+{
+    register rt_base_t level;
+    rt_tick_t deadline;
+    rt_uint32_t density = 0, old = 0;
+    rt_bool_t ready;
+
+    RT_ASSERT(edf != RT_NULL);
+
+    deadline = edf->deadline != 0 ? edf->deadline : edf->period;
+    if (edf->period != 0)
+    {
+        if (edf->runtime == 0)
+            return -RT_EINVAL;
+
+        density = _rt_thread_edf_density(edf->runtime, deadline, edf->period);
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    if (thread->edf_period != 0)
+    {
+        old = _rt_thread_edf_density(thread->edf_runtime,
+                                     thread->edf_rel_deadline,
+                                     thread->edf_period);
+    }
+    if (_edf_density_total - old + density > RT_SCHED_EDF_UTILIZATION * 10)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_EFULL;
+    }
+    _edf_density_total = _edf_density_total - old + density;
+
+    /* the ready queue is ordered by deadline, so take the thread out first */
+    ready = (thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_READY;
+    if (ready)
+        rt_schedule_remove_thread(thread);
+
+    if (edf->period != 0)
+    {
+        /* the first job is released now */
+        thread->edf_release  = rt_tick_get();
+        thread->edf_deadline = thread->edf_release + deadline;
+        thread->edf_missed   = 0;
+
+        /* move to EDF band, the fixed priority is restored on leave */
+        if (thread->edf_period == 0)
+            thread->edf_saved_priority = thread->init_priority;
+        thread->init_priority    = RT_SCHED_EDF_PRIORITY;
+        thread->current_priority = RT_SCHED_EDF_PRIORITY;
+    }
+    else if (thread->edf_period != 0)
+    {
+        /* back to the fixed priority before EDF band */
+        thread->init_priority    = thread->edf_saved_priority;
+        thread->current_priority = thread->edf_saved_priority;
+    }
+    thread->edf_runtime      = edf->runtime;
+    thread->edf_rel_deadline = deadline;
+    thread->edf_period       = edf->period;
+
+#if RT_THREAD_PRIORITY_MAX > 32
+    thread->number      = thread->current_priority >> 5;            /* 3bit */
+    thread->number_mask = 1 << thread->number;
+    thread->high_mask   = 1UL << (thread->current_priority & 0x1f); /* 5bit */
+#else
+    thread->number_mask = 1 << thread->current_priority;
+#endif
+
+    if (ready)
+        rt_schedule_insert_thread(thread);
+
+    rt_hw_interrupt_enable(level);
+
+    if (rt_thread_self() != RT_NULL)
+        rt_schedule();
+
+    return RT_EOK;
+}
+#endif
+
+#ifdef RT_USING_THREAD_BUDGET
+/*
+ * CPU budget works like a sporadic server with one replenishment: the
+ * period starts at the first tick charged to the thread after the last one
+ * ended, and the budget is full again one period later. A thread out of
+ * budget is demoted or suspended until then by its budget timer.
+ */
+
+/* it must be invoked with interrupt disabled */
+static void _rt_thread_budget_lift(struct rt_thread *thread)
+{
+    thread->budget_throttled = 0;
+    thread->budget_remaining = thread->budget;
+
+    if (thread->budget_policy == RT_THREAD_BUDGET_SUSPEND)
+    {
+        if ((thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+            rt_thread_resume(thread);
+    }
+    else
+    {
+        rt_thread_control(thread, RT_THREAD_CTRL_CHANGE_PRIORITY,
+                          &(thread->budget_saved_priority));
+    }
+}
+
+static void _rt_thread_budget_replenish(void *parameter)
+{
+    register rt_base_t level;
+    struct rt_thread *thread = (struct rt_thread *)parameter;
+
+    level = rt_hw_interrupt_disable();
+    thread->budget_start = rt_tick_get();
+    _rt_thread_budget_lift(thread);
+    rt_hw_interrupt_enable(level);
+
+    rt_schedule();
+}
+
+static rt_err_t _rt_thread_budget_set(struct rt_thread *thread, struct rt_thread_budget *budget)
+{
+    register rt_base_t level;
+
+    RT_ASSERT(budget != RT_NULL);
+
+    if (budget->budget != 0 &&
+        (budget->budget > budget->period || budget->priority >= RT_THREAD_PRIORITY_MAX))
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+
+    /* the throttle of old budget ends */
+    if (thread->budget_throttled)
+    {
+        rt_timer_stop(&(thread->budget_timer));
+        _rt_thread_budget_lift(thread);
+    }
+
+    thread->budget           = budget->budget;
+    thread->budget_period    = budget->period;
+    thread->budget_remaining = budget->budget;
+    thread->budget_start     = rt_tick_get();
+    thread->budget_policy    = budget->policy;
+    thread->budget_priority  = budget->priority;
+
+    rt_hw_interrupt_enable(level);
+
+    if (rt_thread_self() != RT_NULL)
+        rt_schedule();
+
+    return RT_EOK;
+}
+#endif
+
 void rt_thread_exit(void)
 {
     struct rt_thread *thread;
@@ -94,8 +290,15 @@ void rt_thread_exit(void)
     /* change stat */
     thread->stat = RT_THREAD_CLOSE;
 
+#ifdef RT_USING_SCHED_EDF
+    _rt_thread_edf_leave(thread);
+#endif
+
     /* remove it from timer list */
     rt_timer_detach(&thread->thread_timer);
+#ifdef RT_USING_THREAD_BUDGET
+    rt_timer_detach(&thread->budget_timer);
+#endif
 
     if ((rt_object_is_systemobject((rt_object_t)thread) == RT_TRUE) &&
         thread->cleanup == RT_NULL)
@@ -150,6 +353,10 @@ static rt_err_t _rt_thread_init(struct rt_thread *thread,
     RT_ASSERT(priority < RT_THREAD_PRIORITY_MAX);
     thread->init_priority    = priority;
     thread->current_priority = priority;
+#ifdef RT_USING_PREEMPT_THRESHOLD
+    /* no threshold */
+    thread->preempt_threshold = RT_THREAD_PRIORITY_MAX - 1;
+#endif
 
     thread->number_mask = 0;
 #if RT_THREAD_PRIORITY_MAX > 32
@@ -169,6 +376,42 @@ static rt_err_t _rt_thread_init(struct rt_thread *thread,
     thread->cleanup   = 0;
     thread->user_data = 0;
 
+#ifdef RT_USING_MEMTRACE
+    thread->mem_slot  = RT_MEMTRACE_SLOT_NONE;
+#endif
+
+#ifdef RT_USING_THREAD_BUDGET
+    thread->budget           = 0;
+    thread->budget_period    = 0;
+    thread->budget_remaining = 0;
+    thread->budget_start     = 0;
+    thread->budget_policy    = RT_THREAD_BUDGET_DEMOTE;
+    thread->budget_priority  = RT_THREAD_PRIORITY_MAX - 1;
+    thread->budget_throttled = 0;
+    thread->budget_overruns  = 0;
+    rt_timer_init(&(thread->budget_timer),
+                  thread->name,
+                  _rt_thread_budget_replenish,
+                  thread,
+                  0,
+                  RT_TIMER_FLAG_ONE_SHOT);
+#endif
+
+#ifdef RT_USING_SCHED_EDF
+    thread->edf_runtime      = 0;
+    thread->edf_rel_deadline = 0;
+    thread->edf_period       = 0;
+    thread->edf_release      = 0;
+    thread->edf_deadline     = 0;
+    thread->edf_missed       = 0;
+    thread->edf_saved_priority = priority;
+#endif
+
+#ifdef RT_USING_LATENCY
+    thread->ready_cycle = 0;
+    rt_memset(&(thread->latency), 0, sizeof(thread->latency));
+#endif
+
     /* init thread timer */
     rt_timer_init(&(thread->thread_timer),
                   thread->name,
@@ -274,9 +517,9 @@ rt_err_t rt_thread_startup(rt_thread_t thread)
 
     /* calculate priority attribute */
 #if RT_THREAD_PRIORITY_MAX > 32
-    thread->number      = thread->current_priority >> 3;            /* 5bit */
+    thread->number      = thread->current_priority >> 5;            /* 3bit */
     thread->number_mask = 1L << thread->number;
-    thread->high_mask   = 1L << (thread->current_priority & 0x07);  /* 3bit */
+    thread->high_mask   = 1UL << (thread->current_priority & 0x1f); /* 5bit */
 #else
     thread->number_mask = 1L << thread->current_priority;
 #endif
@@ -320,8 +563,15 @@ rt_err_t rt_thread_detach(rt_thread_t thread)
         rt_schedule_remove_thread(thread);
     }
 
+#ifdef RT_USING_SCHED_EDF
+    _rt_thread_edf_leave(thread);
+#endif
+
     /* release thread timer */
     rt_timer_detach(&(thread->thread_timer));
+#ifdef RT_USING_THREAD_BUDGET
+    rt_timer_detach(&(thread->budget_timer));
+#endif
 
     /* change stat */
     thread->stat = RT_THREAD_CLOSE;
@@ -419,8 +669,15 @@ rt_err_t rt_thread_delete(rt_thread_t thread)
         rt_schedule_remove_thread(thread);
     }
 
+#ifdef RT_USING_SCHED_EDF
+    _rt_thread_edf_leave(thread);
+#endif
+
     /* release thread timer */
     rt_timer_detach(&(thread->thread_timer));
+#ifdef RT_USING_THREAD_BUDGET
+    rt_timer_detach(&(thread->budget_timer));
+#endif
 
     /* change stat */
     thread->stat = RT_THREAD_CLOSE;
@@ -461,12 +718,23 @@ rt_err_t rt_thread_yield(void)
     if ((thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_READY &&
         thread->tlist.next != thread->tlist.prev)
     {
-        /* remove thread from thread list */
-        rt_list_remove(&(thread->tlist));
+#ifdef RT_USING_SCHED_EDF
+        if (thread->current_priority == RT_SCHED_EDF_PRIORITY)
+        {
+            /* put thread after the ones with the same deadline */
+            rt_schedule_remove_thread(thread);
+            rt_schedule_insert_thread(thread);
+        }
+        else
+#endif
+        {
+            /* remove thread from thread list */
+            rt_list_remove(&(thread->tlist));
 
-        /* put thread to end of ready queue */
-        rt_list_insert_before(&(rt_thread_priority_table[thread->current_priority]),
-                              &(thread->tlist));
+            /* put thread to end of ready queue */
+            rt_list_insert_before(&(rt_thread_priority_table[thread->current_priority]),
+                                  &(thread->tlist));
+        }
 
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
@@ -551,6 +819,130 @@ rt_err_t rt_thread_mdelay(rt_int32_t ms)
 }
 RTM_EXPORT(rt_thread_mdelay);
 
+#ifdef RT_USING_SCHED_EDF
+/**
+ * This function will complete the current job of an EDF thread and let it
+ * sleep until the next job is released, one period after the current one.
+ * A job completed after its deadline is counted as missed. If the next
+ * release is already past, the next job is released at once and the periods
+ * start again from now.
+ *
+ * @return RT_EOK, -RT_ERROR if current thread is not in EDF band
+ */
+rt_err_t rt_thread_edf_wait(void)
+{
+    register rt_base_t level;
+    struct rt_thread *thread;
+    rt_tick_t now, delay;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+    thread = rt_current_thread;
+    if (thread->edf_period == 0)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_ERROR;
+    }
+
+    now = rt_tick_get();
+    if ((rt_int32_t)(now - thread->edf_deadline) > 0)
+        thread->edf_missed ++;
+
+    thread->edf_release += thread->edf_period;
+    if ((rt_int32_t)(thread->edf_release - now) < 0)
+        thread->edf_release = now;
+    thread->edf_deadline = thread->edf_release + thread->edf_rel_deadline;
+
+    delay = thread->edf_release - now;
+    if (delay > 0)
+    {
+        rt_thread_suspend(thread);
+
+        rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &delay);
+        rt_timer_start(&(thread->thread_timer));
+    }
+    else
+    {
+        /* still ready, in the order of the new deadline */
+        rt_schedule_remove_thread(thread);
+        rt_schedule_insert_thread(thread);
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    rt_schedule();
+
+    if (thread->error == -RT_ETIMEOUT)
+        thread->error = RT_EOK;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_thread_edf_wait);
+
+/**
+ * This function will return the utilization admitted in EDF band.
+ *
+ * @return the sum of runtime over the shorter of deadline and period of
+ *         EDF threads, in 1/1000
+ */
+rt_uint32_t rt_thread_edf_utilization(void)
+{
+    return _edf_density_total;
+}
+RTM_EXPORT(rt_thread_edf_utilization);
+#endif
+
+#ifdef RT_USING_THREAD_BUDGET
+/**
+ * This function will charge one tick to the CPU budget of a thread. If the
+ * budget runs out, the thread is demoted or suspended until the end of
+ * period. It is invoked by rt_tick_increase for the running thread.
+ *
+ * @param thread the running thread
+ */
+void rt_thread_budget_charge(rt_thread_t thread)
+{
+    rt_tick_t now, delay;
+
+    if (thread->budget == 0 || thread->budget_throttled)
+        return;
+
+    /* the first tick after the last period ended starts a new one */
+    now = rt_tick_get();
+    if (now - thread->budget_start >= thread->budget_period)
+    {
+        thread->budget_start     = now;
+        thread->budget_remaining = thread->budget;
+    }
+
+    if (-- thread->budget_remaining > 0)
+        return;
+
+    /* out of budget until the end of period */
+    thread->budget_overruns ++;
+    thread->budget_throttled = 1;
+
+    delay = thread->budget_start + thread->budget_period - now;
+    rt_timer_control(&(thread->budget_timer), RT_TIMER_CTRL_SET_TIME, &delay);
+    rt_timer_start(&(thread->budget_timer));
+
+    if (thread->budget_policy == RT_THREAD_BUDGET_SUSPEND)
+    {
+        rt_thread_suspend(thread);
+    }
+    else
+    {
+        thread->budget_saved_priority = thread->current_priority;
+        rt_thread_control(thread, RT_THREAD_CTRL_CHANGE_PRIORITY,
+                          &(thread->budget_priority));
+    }
+
+    rt_schedule();
+}
+#endif
+
 /**
  * This function will control thread behaviors according to control command.
  *
@@ -558,10 +950,19 @@ RTM_EXPORT(rt_thread_mdelay);
  * @param cmd the control command, which includes
  *  RT_THREAD_CTRL_CHANGE_PRIORITY for changing priority level of thread;
  *  RT_THREAD_CTRL_STARTUP for starting a thread;
- *  RT_THREAD_CTRL_CLOSE for delete a thread.
+ *  RT_THREAD_CTRL_CLOSE for delete a thread;
+ *  RT_THREAD_CTRL_SET_EDF for moving a thread to EDF band with the
+ *  struct rt_thread_edf argument, or out of it with a zero period;
+ *  RT_THREAD_CTRL_SET_BUDGET for limiting CPU time of a thread with the
+ *  struct rt_thread_budget argument, or lifting the limit with a zero budget;
+ *  RT_THREAD_CTRL_SET_THRESHOLD for setting the preemption threshold of a
+ *  thread with the rt_uint8_t argument. A running thread is only preempted
+ *  by the threads with a priority above the threshold. A threshold not above
+ *  the priority of thread takes no effect.
  * @param arg the argument of control command
  *
- * @return RT_EOK
+ * @return RT_EOK, -RT_EFULL if EDF band can not admit the thread,
+ *         -RT_EINVAL for the invalid argument
  */
 rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg)
 {
@@ -588,9 +989,9 @@ rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg)
 
             /* recalculate priority attribute */
 #if RT_THREAD_PRIORITY_MAX > 32
-            thread->number      = thread->current_priority >> 3;            /* 5bit */
+            thread->number      = thread->current_priority >> 5;            /* 3bit */
             thread->number_mask = 1 << thread->number;
-            thread->high_mask   = 1 << (thread->current_priority & 0x07);   /* 3bit */
+            thread->high_mask   = 1UL << (thread->current_priority & 0x1f); /* 5bit */
 #else
             thread->number_mask = 1 << thread->current_priority;
 #endif
@@ -604,9 +1005,9 @@ rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg)
 
             /* recalculate priority attribute */
 #if RT_THREAD_PRIORITY_MAX > 32
-            thread->number      = thread->current_priority >> 3;            /* 5bit */
+            thread->number      = thread->current_priority >> 5;            /* 3bit */
             thread->number_mask = 1 << thread->number;
-            thread->high_mask   = 1 << (thread->current_priority & 0x07);   /* 3bit */
+            thread->high_mask   = 1UL << (thread->current_priority & 0x1f); /* 5bit */
 #else
             thread->number_mask = 1 << thread->current_priority;
 #endif
@@ -624,6 +1025,29 @@ rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg)
         return rt_thread_delete(thread);
 #endif
 
+#ifdef RT_USING_SCHED_EDF
+    case RT_THREAD_CTRL_SET_EDF:
+        return _rt_thread_edf_set(thread, (struct rt_thread_edf *)arg);
+#endif
+
+#ifdef RT_USING_THREAD_BUDGET
+    case RT_THREAD_CTRL_SET_BUDGET:
+        return _rt_thread_budget_set(thread, (struct rt_thread_budget *)arg);
+#endif
+
+#ifdef RT_USING_PREEMPT_THRESHOLD
+    case RT_THREAD_CTRL_SET_THRESHOLD:
+        if (*(rt_uint8_t *)arg >= RT_THREAD_PRIORITY_MAX)
+            return -RT_EINVAL;
+
+        thread->preempt_threshold = *(rt_uint8_t *)arg;
+
+        /* a lower threshold may let a ready thread preempt now */
+        if (rt_thread_self() != RT_NULL)
+            rt_schedule();
+        break;
+#endif
+
     default:
         break;
     }
@@ -764,38 +1188,8 @@ RTM_EXPORT(rt_thread_timeout);
  */
 rt_thread_t rt_thread_find(char *name)
 {
-    struct rt_object_information *information;
-    struct rt_object *object;
-    struct rt_list_node *node;
-
-    /* enter critical */
-    if (rt_thread_self() != RT_NULL)
-        rt_enter_critical();
-
-    /* try to find device object */
-    information = rt_object_get_information(RT_Object_Class_Thread);
-    RT_ASSERT(information != RT_NULL);
-    for (node  = information->object_list.next;
-         node != &(information->object_list);
-         node  = node->next)
-    {
-        object = rt_list_entry(node, struct rt_object, list);
-        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
-        {
-            /* leave critical */
-            if (rt_thread_self() != RT_NULL)
-                rt_exit_critical();
-
-            return (rt_thread_t)object;
-        }
-    }
-
-    /* leave critical */
-    if (rt_thread_self() != RT_NULL)
-        rt_exit_critical();
-
-    /* not found */
-    return RT_NULL;
+    /* the same lookup as device, by the name index if any */
+    return (rt_thread_t)rt_object_find(name, RT_Object_Class_Thread);
 }
 RTM_EXPORT(rt_thread_find);
 
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ * 2026-10-19     tangmenglin  dump with direct rt_kprintf, out of critical section.
+ */
+
+/*
+ * Binary event trace recorder.
+ *
+ * The recorder installs the hooks of scheduler, IPC objects, interrupt and
+ * timer, and logs each event as an 8 bytes record into a ring buffer: the
+ * cycle count with its low 3 bits replaced by the event, and the object of
+ * event. When the ring is full, the oldest record is overwritten, so the
+ * buffer always holds the last RT_TRACE_BUF_SIZE events before a snapshot.
+ *
+ *   RT_TRACE_SWITCH                the thread switched to
+ *   RT_TRACE_TRYTAKE/TAKE/PUT      the IPC object, in the current thread
+ *   RT_TRACE_IRQ_ENTER/LEAVE       the nest of interrupt
+ *   RT_TRACE_TIMER_ENTER/EXIT      the timer
+ *
+ * The trace shell command dumps the objects and records in hex, which are
+ * converted to the Chrome trace event format, for Perfetto or
+ * chrome://tracing, by tools/trace/trace2json on the host.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_TRACE
+
+#ifndef RT_USING_HOOK
+#error "RT_USING_TRACE requires RT_USING_HOOK"
+#endif
+
+#ifndef RT_TRACE_BUF_SIZE
+#define RT_TRACE_BUF_SIZE           512
+#endif
+
+/* the objects named in a dump, the others show as addresses */
+#ifndef RT_TRACE_OBJECTS
+#define RT_TRACE_OBJECTS            64
+#endif
+
+/* the frequency of cycle counter, 0 if the host tool is told */
+#ifdef RT_CPU_CLOCK_HZ
+#define TRACE_CYCLES_PER_SECOND     RT_CPU_CLOCK_HZ
+#else
+#define TRACE_CYCLES_PER_SECOND     0
+#endif
+
+static struct rt_trace_record trace_buf[RT_TRACE_BUF_SIZE];
+static rt_uint16_t trace_head;
+static rt_uint16_t trace_count;
+static rt_uint32_t trace_lost;
+static rt_bool_t trace_started;
+
+static void trace_put(rt_uint32_t event, rt_uint32_t object)
+{
+    rt_base_t level;
+    struct rt_trace_record *record;
+
+    level = rt_hw_interrupt_disable();
+    record = &trace_buf[trace_head];
+    record->timestamp = (rt_hw_cycle_get() & ~RT_TRACE_EVENT_MASK) | event;
+    record->object    = object;
+
+    if (++ trace_head == RT_TRACE_BUF_SIZE)
+        trace_head = 0;
+    if (trace_count < RT_TRACE_BUF_SIZE)
+        trace_count ++;
+    else
+        trace_lost ++;
+    rt_hw_interrupt_enable(level);
+}
+
+static void trace_switch_hook(struct rt_thread *from, struct rt_thread *to)
+{
+    trace_put(RT_TRACE_SWITCH, (rt_uint32_t)to);
+}
+
+static void trace_trytake_hook(struct rt_object *object)
+{
+    trace_put(RT_TRACE_TRYTAKE, (rt_uint32_t)object);
+}
+
+static void trace_take_hook(struct rt_object *object)
+{
+    trace_put(RT_TRACE_TAKE, (rt_uint32_t)object);
+}
+
+static void trace_put_hook(struct rt_object *object)
+{
+    trace_put(RT_TRACE_PUT, (rt_uint32_t)object);
+}
+
+static void trace_irq_enter_hook(void)
+{
+    trace_put(RT_TRACE_IRQ_ENTER, rt_interrupt_get_nest());
+}
+
+static void trace_irq_leave_hook(void)
+{
+    trace_put(RT_TRACE_IRQ_LEAVE, rt_interrupt_get_nest());
+}
+
+static void trace_timer_enter_hook(struct rt_timer *timer)
+{
+    trace_put(RT_TRACE_TIMER_ENTER, (rt_uint32_t)timer);
+}
+
+static void trace_timer_exit_hook(struct rt_timer *timer)
+{
+    trace_put(RT_TRACE_TIMER_EXIT, (rt_uint32_t)timer);
+}
+
+/**
+ * @addtogroup Kernel
+ */
+
+/**@{*/
+
+/**
+ * This function will start recording events. It installs the hooks of
+ * scheduler, IPC objects, interrupt and timer.
+ */
+void rt_trace_start(void)
+{
+    trace_started = RT_TRUE;
+
+    rt_scheduler_sethook(trace_switch_hook);
+    rt_object_trytake_sethook(trace_trytake_hook);
+    rt_object_take_sethook(trace_take_hook);
+    rt_object_put_sethook(trace_put_hook);
+    rt_interrupt_enter_sethook(trace_irq_enter_hook);
+    rt_interrupt_leave_sethook(trace_irq_leave_hook);
+    rt_timer_enter_sethook(trace_timer_enter_hook);
+    rt_timer_exit_sethook(trace_timer_exit_hook);
+}
+RTM_EXPORT(rt_trace_start);
+
+/**
+ * This function will stop recording events. The records in ring buffer are
+ * kept until they are cleared.
+ */
+void rt_trace_stop(void)
+{
+    rt_scheduler_sethook(RT_NULL);
+    rt_object_trytake_sethook(RT_NULL);
+    rt_object_take_sethook(RT_NULL);
+    rt_object_put_sethook(RT_NULL);
+    rt_interrupt_enter_sethook(RT_NULL);
+    rt_interrupt_leave_sethook(RT_NULL);
+    rt_timer_enter_sethook(RT_NULL);
+    rt_timer_exit_sethook(RT_NULL);
+
+    trace_started = RT_FALSE;
+}
+RTM_EXPORT(rt_trace_stop);
+
+/**
+ * This function will discard all of records and reset the lost counter.
+ */
+void rt_trace_clear(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    trace_head  = 0;
+    trace_count = 0;
+    trace_lost  = 0;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_trace_clear);
+
+/**
+ * This function will copy the newest records from ring buffer, the oldest
+ * first. The records stay in ring buffer.
+ *
+ * @param buffer the buffer to save records
+ * @param count the maximal number of records
+ *
+ * @return the number of records copied
+ */
+rt_size_t rt_trace_snapshot(struct rt_trace_record *buffer, rt_size_t count)
+{
+    rt_base_t level;
+    rt_size_t index;
+    int read;
+
+    level = rt_hw_interrupt_disable();
+    if (count > trace_count)
+        count = trace_count;
+
+    read = trace_head - count;
+    if (read < 0)
+        read += RT_TRACE_BUF_SIZE;
+
+    for (index = 0; index < count; index++)
+    {
+        buffer[index] = trace_buf[read];
+        if (++ read == RT_TRACE_BUF_SIZE)
+            read = 0;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return count;
+}
+RTM_EXPORT(rt_trace_snapshot);
+
+/**
+ * This function will return the number of records overwritten because the
+ * ring buffer was full.
+ *
+ * @return the number of lost records
+ */
+rt_uint32_t rt_trace_lost(void)
+{
+    return trace_lost;
+}
+RTM_EXPORT(rt_trace_lost);
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+struct trace_object
+{
+    rt_uint32_t address;
+    rt_uint8_t type;
+    char name[RT_NAME_MAX];
+};
+
+static struct trace_object trace_objects[RT_TRACE_OBJECTS];
+
+/* copy the object map, which resolves the object field of records */
+static int trace_objects_get(void)
+{
+    static const rt_uint8_t classes[] =
+    {
+        RT_Object_Class_Thread, RT_Object_Class_Semaphore, RT_Object_Class_Mutex,
+        RT_Object_Class_Event, RT_Object_Class_MailBox, RT_Object_Class_MessageQueue,
+        RT_Object_Class_Timer,
+    };
+    struct rt_list_node *node;
+    struct rt_object_information *information;
+    struct rt_object *object;
+    int index, count = 0;
+
+    rt_enter_critical();
+    for (index = 0; index < sizeof(classes) / sizeof(classes[0]); index++)
+    {
+        information = rt_object_get_information((enum rt_object_class_type)classes[index]);
+        if (information == RT_NULL)
+            continue;
+
+        for (node  = information->object_list.next;
+             node != &(information->object_list) && count < RT_TRACE_OBJECTS;
+             node  = node->next)
+        {
+            object = rt_list_entry(node, struct rt_object, list);
+
+            trace_objects[count].address = (rt_uint32_t)object;
+            trace_objects[count].type    = classes[index];
+            rt_memcpy(trace_objects[count].name, object->name, RT_NAME_MAX);
+            count ++;
+        }
+    }
+    rt_exit_critical();
+
+    return count;
+}
+
+static void trace_dump(void)
+{
+    struct rt_trace_record record;
+    rt_bool_t started;
+    int index, read, count;
+
+    /* the dump itself is not recorded */
+    started = trace_started;
+    if (started)
+        rt_trace_stop();
+
+    /* the dump is far more than the ring of asynchronous rt_kprintf holds */
+    rt_kprintf_sync(RT_TRUE);
+
+    rt_kprintf("# trace: %d records, %d lost, %d cycles per second\n",
+               trace_count, trace_lost, TRACE_CYCLES_PER_SECOND);
+
+    count = trace_objects_get();
+    for (index = 0; index < count; index++)
+    {
+        rt_kprintf("O %08x %d %.*s\n", trace_objects[index].address,
+                   trace_objects[index].type, RT_NAME_MAX, trace_objects[index].name);
+    }
+
+    read = trace_head - trace_count;
+    if (read < 0)
+        read += RT_TRACE_BUF_SIZE;
+
+    for (index = 0; index < trace_count; index++)
+    {
+        record = trace_buf[read];
+        if (++ read == RT_TRACE_BUF_SIZE)
+            read = 0;
+
+        rt_kprintf("%08x %08x\n", record.timestamp, record.object);
+    }
+
+    rt_kprintf_sync(RT_FALSE);
+
+    if (started)
+        rt_trace_start();
+}
+
+int trace(int argc, char **argv)
+{
+    if (argc == 2)
+    {
+        if (!rt_strcmp(argv[1], "start"))
+        {
+            rt_trace_start();
+            return 0;
+        }
+        else if (!rt_strcmp(argv[1], "stop"))
+        {
+            rt_trace_stop();
+            return 0;
+        }
+        else if (!rt_strcmp(argv[1], "clear"))
+        {
+            rt_trace_clear();
+            return 0;
+        }
+        else if (!rt_strcmp(argv[1], "snapshot"))
+        {
+            trace_dump();
+            return 0;
+        }
+    }
+
+    rt_kprintf("usage: trace start|stop|clear|snapshot\n");
+
+    return -RT_EINVAL;
+}
+MSH_CMD_EXPORT(trace, record kernel events: start|stop|clear|snapshot);
+#endif /* end of RT_USING_FINSH */
+
+#endif /* end of RT_USING_TRACE */
@@ -7,32 +7,64 @@
 
 static rt_uint32_t seven_segment_value = 0x02111254; // Default: Your student ID
 
+// LED Toggling based on count
+static void display_blink(rt_uint32_t count)
+{
+    if (count % 2 == 0)
+    {
+        bsp_led_write(0xAAAA);
+    }
+    else
+    {
+        bsp_led_write(0x5555);
+    }
+
+    // Update 7-segment if needed (could be controlled by a message or global var)
+    // bsp_seg_digit_write(seven_segment_value); // uncomment if it changes
+}
+
+#ifdef RT_USING_PERIODIC
+// Blink every second, called by the thread of its rate group
+static void display_task_callback(void *parameter)
+{
+    static rt_uint32_t count = 0;
+
+    if (count == 0)
+    {
+        bsp_seg_digit_write(seven_segment_value); // Initial display
+    }
+    display_blink(count++);
+}
+
+RT_PERIODIC_TASK_DEFINE(display_task, 1000, 0, display_task_callback, RT_NULL);
+#else
 static void display_thread_entry(void *parameter)
 {
     rt_uint32_t count = 0;
+#ifdef RT_USING_SCHED_EDF
+    // Blink every second in the EDF band, deadline at the end of period
+    struct rt_thread_edf edf = {rt_tick_from_millisecond(2),
+                                0,
+                                rt_tick_from_millisecond(1000)};
+
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_SET_EDF, &edf);
+#endif
     rt_kprintf("Display thread started.\n");
 
     bsp_seg_digit_write(seven_segment_value); // Initial display
 
     while (1)
     {
-        // LED Toggling based on count
-        if (count % 2 == 0)
-        {
-            bsp_led_write(0xAAAA);
-        }
-        else
-        {
-            bsp_led_write(0x5555);
-        }
-        count++;
-
-        // Update 7-segment if needed (could be controlled by a message or global var)
-        // bsp_seg_digit_write(seven_segment_value); // uncomment if it changes
+        display_blink(count++);
 
+#ifdef RT_USING_SCHED_EDF
+        rt_thread_edf_wait(); // Next blink, one period after this one
+#else
         rt_thread_mdelay(1000); // Blink LEDs every 1 second
+#endif
     }
 }
+#endif
 
 // Optional: function for other threads to change the 7-seg display
 void display_update_seg(rt_uint32_t seg_val)
@@ -42,19 +74,13 @@ void display_update_seg(rt_uint32_t seg_val)
     bsp_seg_digit_write(seven_segment_value); // Update immediately or let thread pick it up
 }
 
-int display_thread_init(void)
-{
-    rt_thread_t tid = rt_thread_create("display",
-                                       display_thread_entry,
-                                       RT_NULL,
-                                       DISPLAY_THREAD_STACK_SIZE,
-                                       DISPLAY_THREAD_PRIO,
-                                       DISPLAY_THREAD_TIMESLICE);
-    if (tid != RT_NULL)
-    {
-        rt_thread_startup(tid);
-        return RT_EOK;
-    }
-    rt_kprintf("Failed to create display thread.\n");
-    return -RT_ERROR;
-}
\ No newline at end of file
+#ifndef RT_USING_PERIODIC
+// Permanent display thread, started by the kernel during components initialization
+RT_THREAD_DEFINE(display_thread,
+                 "display",
+                 display_thread_entry,
+                 RT_NULL,
+                 DISPLAY_THREAD_STACK_SIZE,
+                 DISPLAY_THREAD_PRIO,
+                 DISPLAY_THREAD_TIMESLICE);
+#endif
\ No newline at end of file
@@ -3,7 +3,9 @@
 
 #include <rtthread.h>
 
-int display_thread_init(void);
+#ifndef RT_USING_PERIODIC
+extern struct rt_thread display_thread; // Statically defined, started at boot
+#endif
 void display_update_seg(rt_uint32_t seg_val); // Optional: function to allow other threads to update 7-seg
 
 #endif // DISPLAY_THREAD_H__
\ No newline at end of file
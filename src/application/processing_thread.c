@@ -61,7 +61,7 @@ static void processing_thread_entry(void *parameter)
                 // rt_uint8_t temp_display_val = (received_data.temperature / 10);
                 // display_update_seg(some_conversion_to_7seg_pattern(temp_display_val));
             }
-            else
+            else if (sensor_data_mq != RT_NULL) // Not woken up by sensor_demo_stop()
             {
                 rt_kprintf("Processing: Failed to receive from MQ, error %d\n", result);
             }
@@ -73,19 +73,11 @@ static void processing_thread_entry(void *parameter)
     }
 }
 
-int processing_thread_init(void)
-{
-    rt_thread_t tid = rt_thread_create("process",
-                                       processing_thread_entry,
-                                       RT_NULL,
-                                       PROCESSING_THREAD_STACK_SIZE,
-                                       PROCESSING_THREAD_PRIO,
-                                       PROCESSING_THREAD_TIMESLICE);
-    if (tid != RT_NULL)
-    {
-        rt_thread_startup(tid);
-        return RT_EOK;
-    }
-    rt_kprintf("Failed to create processing thread.\n");
-    return -RT_ERROR;
-}
\ No newline at end of file
+// Started at boot; it idles until sensor_demo_start() attaches the message queue
+RT_THREAD_DEFINE(processing_thread,
+                 "process",
+                 processing_thread_entry,
+                 RT_NULL,
+                 PROCESSING_THREAD_STACK_SIZE,
+                 PROCESSING_THREAD_PRIO,
+                 PROCESSING_THREAD_TIMESLICE);
\ No newline at end of file
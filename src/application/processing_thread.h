@@ -3,6 +3,6 @@
 
 #include <rtthread.h>
 
-int processing_thread_init(void);
+extern struct rt_thread processing_thread; // Statically defined, started at boot
 
 #endif // PROCESSING_THREAD_H__
\ No newline at end of file
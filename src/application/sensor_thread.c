@@ -4,13 +4,68 @@
 #define SENSOR_THREAD_PRIO      10
 #define SENSOR_THREAD_STACK_SIZE 512
 #define SENSOR_THREAD_TIMESLICE 10
+#define SENSOR_THREAD_THRESHOLD 9 // Priority of the processing thread
 
-// Message queue handle, defined in main.c or a global place
+#define SENSOR_MQ_MAX_MSGS 5
+
+// Message queue of the DEMO, initialized by the kernel at boot
+RT_MQ_DEFINE(sensor_mq,
+             "sensorMQ",
+             sizeof(struct sensor_data),
+             SENSOR_MQ_MAX_MSGS,
+             RT_IPC_FLAG_PRIO);
+
+// Message queue handle, RT_NULL while the DEMO is stopped
 rt_mq_t sensor_data_mq = RT_NULL;
 
-static void sensor_thread_entry(void *parameter)
+// Simulate one sample and send it while the DEMO is running
+static void sensor_sample(void)
 {
     struct sensor_data data;
+
+    data.temperature = (rand() % 600) - 200; // Temp range: -20.0 to +39.9 C (scaled by 10)
+    data.humidity = rand() % 101;             // Humidity: 0 to 100 %
+
+    if (sensor_data_mq != RT_NULL)
+    {
+        rt_err_t result = rt_mq_send(sensor_data_mq, &data, sizeof(struct sensor_data));
+        if (result != RT_EOK)
+        {
+            rt_kprintf("Sensor: Failed to send data to MQ, error %d\n", result);
+        }
+        else
+        {
+            // rt_kprintf("Sensor: Sent Temp %d, Hum %d\n", data.temperature, data.humidity);
+        }
+    }
+}
+
+#ifdef RT_USING_PERIODIC
+// A sample every 2 seconds, in the same rate group as the display
+static void sensor_task_callback(void *parameter)
+{
+    sensor_sample();
+}
+
+RT_PERIODIC_TASK_DEFINE(sensor_task, 2000, 0, sensor_task_callback, RT_NULL);
+#else
+static void sensor_thread_entry(void *parameter)
+{
+#ifdef RT_USING_SCHED_EDF
+    // A sample every 2 seconds in the EDF band, done within 100 ms
+    struct rt_thread_edf edf = {rt_tick_from_millisecond(5),
+                                rt_tick_from_millisecond(100),
+                                rt_tick_from_millisecond(2000)};
+
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_SET_EDF, &edf);
+#endif
+#ifdef RT_USING_PREEMPT_THRESHOLD
+    // The processing thread waits until this thread sleeps instead of
+    // preempting it on every rt_mq_send
+    rt_uint8_t threshold = SENSOR_THREAD_THRESHOLD;
+
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_SET_THRESHOLD, &threshold);
+#endif
     rt_kprintf("Sensor thread started.\n");
 
     // Seed random number generator (optional, do once)
@@ -18,39 +73,36 @@ static void sensor_thread_entry(void *parameter)
 
     while (1)
     {
-        // Simulate sensor data
-        data.temperature = (rand() % 600) - 200; // Temp range: -20.0 to +39.9 C (scaled by 10)
-        data.humidity = rand() % 101;             // Humidity: 0 to 100 %
-
-        if (sensor_data_mq != RT_NULL)
-        {
-            rt_err_t result = rt_mq_send(sensor_data_mq, &data, sizeof(struct sensor_data));
-            if (result != RT_EOK)
-            {
-                rt_kprintf("Sensor: Failed to send data to MQ, error %d\n", result);
-            }
-            else
-            {
-                // rt_kprintf("Sensor: Sent Temp %d, Hum %d\n", data.temperature, data.humidity);
-            }
-        }
+        sensor_sample();
+#ifdef RT_USING_SCHED_EDF
+        rt_thread_edf_wait(); // Next sample, one period after this one
+#else
         rt_thread_mdelay(2000); // Send data every 2 seconds
+#endif
     }
 }
 
-int sensor_thread_init(void)
+// Started at boot; it only sends data while the DEMO is running
+RT_THREAD_DEFINE(sensor_thread,
+                 "sensor",
+                 sensor_thread_entry,
+                 RT_NULL,
+                 SENSOR_THREAD_STACK_SIZE,
+                 SENSOR_THREAD_PRIO,
+                 SENSOR_THREAD_TIMESLICE);
+#endif
+
+void sensor_demo_start(void)
+{
+    sensor_data_mq = &sensor_mq;
+}
+
+void sensor_demo_stop(void)
 {
-    rt_thread_t tid = rt_thread_create("sensor",
-                                       sensor_thread_entry,
-                                       RT_NULL,
-                                       SENSOR_THREAD_STACK_SIZE,
-                                       SENSOR_THREAD_PRIO,
-                                       SENSOR_THREAD_TIMESLICE);
-    if (tid != RT_NULL)
+    if (sensor_data_mq != RT_NULL)
     {
-        rt_thread_startup(tid);
-        return RT_EOK;
+        sensor_data_mq = RT_NULL;
+        // Drop queued data and wake the processing thread, it then idles
+        rt_mq_control(&sensor_mq, RT_IPC_CMD_RESET, RT_NULL);
     }
-    rt_kprintf("Failed to create sensor thread.\n");
-    return -RT_ERROR;
 }
\ No newline at end of file
@@ -10,8 +10,9 @@ struct sensor_data
     rt_uint8_t humidity;    // e.g., percentage (0-100)
 };
 
-extern rt_mq_t sensor_data_mq; // Message queue handle
+extern rt_mq_t sensor_data_mq; // Message queue handle, RT_NULL while the DEMO is stopped
 
-int sensor_thread_init(void);
+void sensor_demo_start(void); // Attach the message queue, sensor and processing threads start working
+void sensor_demo_stop(void);  // Detach the message queue, both threads idle
 
 #endif // SENSOR_THREAD_H__
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <rtthread.h>
+
+#ifdef RT_USING_CYCLIC
+
+#define CTRL_THREAD_PRIORITY    1       /* 时间触发的线程优先级最高 */
+#define CTRL_THREAD_STACK_SIZE  512
+
+/* 模拟的被控对象：输入随执行器输出一阶变化 */
+static volatile rt_int32_t ctrl_input, ctrl_output, ctrl_actuator;
+static rt_int32_t ctrl_integral;
+
+/* 每帧开始时在时钟中断中采样输入 */
+static void ctrl_read(void)
+{
+    ctrl_input += (ctrl_actuator - ctrl_input) / 8;
+}
+
+/* 在固定的时刻把输出送到执行器，与控制线程的运行时间无关 */
+static void ctrl_write(void)
+{
+    ctrl_actuator = ctrl_output;
+}
+
+/* 控制线程每帧运行两次，每次预算 2 个节拍 */
+static void ctrl_entry(void *parameter)
+{
+    struct rt_cyclic_slot *slot;
+    rt_int32_t error;
+
+    while (1)
+    {
+        slot = rt_cyclic_wait();
+        if (slot == RT_NULL)
+            continue;
+
+        error = 1000 - ctrl_input;
+        ctrl_integral += error;
+        ctrl_output = error * 4 + ctrl_integral / 16;
+    }
+}
+
+RT_THREAD_DEFINE(cyclic_ctrl, "ctrl", ctrl_entry, RT_NULL,
+                 CTRL_THREAD_STACK_SIZE, CTRL_THREAD_PRIORITY, 10);
+
+/* 主帧 RT_CYCLIC_MAJOR_FRAME 个节拍内的静态调度表 */
+RT_CYCLIC_SLOT(ctrl_in,    0, 0, ctrl_read,  RT_NULL);
+RT_CYCLIC_SLOT(ctrl_law0,  1, 2, RT_NULL,    &cyclic_ctrl);
+RT_CYCLIC_SLOT(ctrl_out,   4, 0, ctrl_write, RT_NULL);
+RT_CYCLIC_SLOT(ctrl_law1,  6, 2, RT_NULL,    &cyclic_ctrl);
+
+static void cyclic_sample_show(struct rt_cyclic_slot *slot)
+{
+    rt_kprintf("%-10s runs %5d jitter %6d cycles overruns %d skips %d\n", slot->name, slot->runs,
+               slot->runs ? slot->latency_max - slot->latency_min : 0,
+               slot->overruns, slot->skips);
+}
+
+/* 时间触发调度示例：运行 1 秒后打印每个时隙的抖动 */
+int cyclic_sample(void)
+{
+    rt_kprintf("\n时间触发调度示例\n");
+
+    rt_cyclic_start();
+    rt_thread_mdelay(1000);
+    rt_cyclic_stop();
+
+    cyclic_sample_show(&ctrl_in);
+    cyclic_sample_show(&ctrl_law0);
+    cyclic_sample_show(&ctrl_out);
+    cyclic_sample_show(&ctrl_law1);
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(cyclic_sample, time-triggered cyclic executive sample);
+#endif
@@ -0,0 +1,123 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+#define BENCH_PATTERNS      64
+#define BENCH_LOOPS         64
+
+static rt_uint8_t lowest_bit[256];
+static rt_uint32_t bench_group[BENCH_PATTERNS];         /* 32 级优先级 */
+
+/* 原来 256 级优先级的布局：32 位的组，每组一个字节对应 8 级 */
+static rt_uint32_t bench_group8[BENCH_PATTERNS];
+static rt_uint8_t bench_table8[BENCH_PATTERNS][32];
+
+/* 现在的布局：8 位的组，每组一个字对应 32 级 */
+static rt_uint32_t bench_group32[BENCH_PATTERNS];
+static rt_uint32_t bench_table32[BENCH_PATTERNS][8];
+
+/* 查表法，与 kservice.c 的 __rt_ffs 相同 */
+static int ffs_table(rt_uint32_t value)
+{
+    if (value == 0)
+        return 0;
+
+    if (value & 0xff)
+        return lowest_bit[value & 0xff] + 1;
+
+    if (value & 0xff00)
+        return lowest_bit[(value & 0xff00) >> 8] + 9;
+
+    if (value & 0xff0000)
+        return lowest_bit[(value & 0xff0000) >> 16] + 17;
+
+    return lowest_bit[(value & 0xff000000) >> 24] + 25;
+}
+
+/* ctz 指令，没有 Zbb 时是 libgcc 的函数调用 */
+static int ffs_ctz(rt_uint32_t value)
+{
+    if (value == 0)
+        return 0;
+
+    return __builtin_ctz(value) + 1;
+}
+
+/* 生成随机的就绪位图，每个有空闲线程和 3 个其它就绪线程 */
+static void ffs_bench_init(void)
+{
+    rt_uint32_t seed = 12345, prio;
+    int i, j;
+
+    for (i = 1; i < 256; i++)
+        lowest_bit[i] = __builtin_ctz(i);
+
+    for (i = 0; i < BENCH_PATTERNS; i++)
+    {
+        /* 空闲线程总是就绪 */
+        bench_group[i] = 1UL << 31;
+        bench_group8[i] = 1UL << 31;
+        bench_table8[i][31] = 0x80;
+        bench_group32[i] = 1UL << 7;
+        bench_table32[i][7] = 1UL << 31;
+
+        for (j = 0; j < 3; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            prio = (seed >> 16) & 0xff;
+
+            bench_group[i] |= 1UL << (prio & 0x1f);
+            bench_group8[i] |= 1UL << (prio >> 3);
+            bench_table8[i][prio >> 3] |= 1 << (prio & 0x07);
+            bench_group32[i] |= 1UL << (prio >> 5);
+            bench_table32[i][prio >> 5] |= 1UL << (prio & 0x1f);
+        }
+    }
+}
+
+/* 求最高就绪优先级的平均周期数 */
+#define FFS_BENCH_RUN(label, expr)                                          \
+    do                                                                      \
+    {                                                                       \
+        start = rt_hw_cycle_get();                                          \
+        for (loop = 0; loop < BENCH_LOOPS; loop++)                          \
+        {                                                                   \
+            for (i = 0; i < BENCH_PATTERNS; i++)                            \
+                sum += (expr);                                              \
+        }                                                                   \
+        cycles = rt_hw_cycle_get() - start;                                 \
+        rt_kprintf(" %-18s %4d\n", label,                                   \
+                   cycles / (BENCH_LOOPS * BENCH_PATTERNS));                \
+    } while (0)
+
+int ffs_bench(void)
+{
+    rt_uint32_t start, cycles, number;
+    volatile rt_uint32_t sum = 0;
+    int i, loop;
+
+    ffs_bench_init();
+
+    rt_kprintf("\n最高就绪优先级的计算 (单位: 周期)\n");
+
+    FFS_BENCH_RUN("32 table", ffs_table(bench_group[i]) - 1);
+    FFS_BENCH_RUN("32 ctz", ffs_ctz(bench_group[i]) - 1);
+    FFS_BENCH_RUN("32 __rt_ffs", __rt_ffs(bench_group[i]) - 1);
+
+    FFS_BENCH_RUN("256 8-bit table",
+                  (number = ffs_table(bench_group8[i]) - 1,
+                   (number << 3) + ffs_table(bench_table8[i][number]) - 1));
+    FFS_BENCH_RUN("256 8-bit ctz",
+                  (number = ffs_ctz(bench_group8[i]) - 1,
+                   (number << 3) + ffs_ctz(bench_table8[i][number]) - 1));
+    FFS_BENCH_RUN("256 32-bit table",
+                  (number = ffs_table(bench_group32[i]) - 1,
+                   (number << 5) + ffs_table(bench_table32[i][number]) - 1));
+    FFS_BENCH_RUN("256 32-bit ctz",
+                  (number = ffs_ctz(bench_group32[i]) - 1,
+                   (number << 5) + ffs_ctz(bench_table32[i][number]) - 1));
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(ffs_bench, highest ready priority lookup benchmark);
@@ -20,7 +20,7 @@ void thread_entry(void *parameter)
         /* 恢复全局中断 */
         rt_hw_interrupt_enable(level);
 
-        rt_kprintf("protect thread[%d]'s counter is %d\n", no, cnt);
+        rt_ktoken_printf("protect thread[%d]'s counter is %d\n", no, cnt);
         rt_thread_mdelay(no * 10);
     }
 }
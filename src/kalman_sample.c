@@ -60,14 +60,8 @@ static void kalman_thread_entry(void *parameter)
         float measurement = get_sensor_data();
         float filtered = kalman_update(&kf, measurement);
         
-        /* 将浮点数拆分为整数和小数部分 */
-        int meas_int = (int)measurement;
-        int meas_frac = (int)((measurement - meas_int) * 1000);
-        int filt_int = (int)filtered;
-        int filt_frac = (int)((filtered - filt_int) * 1000);
-        
-        rt_kprintf("Sample %d: Raw = %d.%03d, Filtered = %d.%03d\n", 
-                   count, meas_int, meas_frac, filt_int, filt_frac);
+        rt_ktoken_printf("Sample %d: Raw = %.3f, Filtered = %.3f\n",
+                         count, measurement, filtered);
         
         count++;
         rt_thread_mdelay(1000);
@@ -0,0 +1,69 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+#ifdef RT_USING_KTOKEN
+
+#define BENCH_LOOPS         16
+
+static char bench_text[RT_CONSOLEBUF_SIZE];
+static rt_uint8_t bench_record[64];
+
+/* 各测试项的平均周期数 */
+#define BENCH_RUN(expr)                                     \
+    do                                                      \
+    {                                                       \
+        int i;                                              \
+        rt_uint32_t start = rt_hw_cycle_get();              \
+        for (i = 0; i < BENCH_LOOPS; i++)                   \
+        {                                                   \
+            expr;                                           \
+        }                                                   \
+        cycles = (rt_hw_cycle_get() - start) / BENCH_LOOPS; \
+    } while (0)
+
+/* 文本与令牌两种方式：格式化（编码）周期数和串口输出字节数 */
+#define BENCH_LOG(name, fmt, ...)                                                   \
+    do                                                                              \
+    {                                                                               \
+        rt_uint32_t text_cycles, text_bytes, token_bytes;                           \
+        BENCH_RUN(text_bytes = rt_snprintf(bench_text, sizeof(bench_text),          \
+                                           fmt, ##__VA_ARGS__));                    \
+        text_cycles = cycles;                                                       \
+        BENCH_RUN(token_bytes = rt_ktoken_encode(bench_record, sizeof(bench_record),\
+                                                 RT_KTOKEN(fmt, ##__VA_ARGS__),     \
+                                                 ##__VA_ARGS__));                   \
+        /* '$'、base64 和换行符 */                                                  \
+        token_bytes = 1 + (token_bytes * 4 + 2) / 3 + 1;                            \
+        rt_kprintf("%-10s %6d %6d %8d %8d\n", name,                                 \
+                   text_bytes, token_bytes, text_cycles, cycles);                   \
+        total_text += text_bytes;                                                   \
+        total_token += token_bytes;                                                 \
+    } while (0)
+
+int ktoken_bench(void)
+{
+    rt_uint32_t cycles;
+    rt_uint32_t total_text = 0, total_token = 0;
+    volatile float raw = 23.456f, filtered = 23.117f;
+    volatile int count = 42;
+    volatile char ch = 'C';
+
+    rt_kprintf("\n令牌化日志测试 (字节数, 单位: 周期)\n");
+    rt_kprintf("sample      text  token  snprintf  encode\n");
+
+    /* 各示例程序循环中的日志 */
+    BENCH_LOG("kalman", "Sample %d: Raw = %.3f, Filtered = %.3f\n", count, raw, filtered);
+    BENCH_LOG("thread", "thread1 count: %d\n", count);
+    BENCH_LOG("msgq", "thread2: send message - %c\n", ch);
+    BENCH_LOG("mempool", "allocate No.%d\n", count);
+    BENCH_LOG("interrupt", "protect thread[%d]'s counter is %d\n", 1, count);
+    BENCH_LOG("mutex", "not protect.number1 = %d, mumber2 = %d \n", count, count + 1);
+
+    rt_kprintf("total      %6d %6d\n", total_text, total_token);
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(ktoken_bench, tokenized logging size and speed benchmark);
+#endif /* RT_USING_KTOKEN */
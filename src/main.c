@@ -14,14 +14,10 @@ extern int interrupt_sample(void);
 extern int mutex_sample(void);
 extern int kalman_sample(void);
 
-// Global handles for dynamically created sample threads and demo threads
+// Global handle for dynamically created sample threads.
+// The display, sensor and processing threads and the DEMO message queue are
+// statically defined (RT_THREAD_DEFINE / RT_MQ_DEFINE) and started at boot.
 static rt_thread_t active_sample_thread = RT_NULL;
-static rt_thread_t demo_sensor_thread_handle = RT_NULL;     // Store handle if sensor_thread_init returns it
-static rt_thread_t demo_processing_thread_handle = RT_NULL; // Store handle
-
-// Message Queue for the DEMO
-#define SENSOR_MQ_MAX_MSGS 5
-static rt_uint8_t sensor_mq_pool[sizeof(struct sensor_data) * SENSOR_MQ_MAX_MSGS];
 
 // Helper to stop any currently running dynamic sample or demo threads
 static void stop_active_threads_and_ipc(void)
@@ -35,28 +31,12 @@ static void stop_active_threads_and_ipc(void)
         active_sample_thread = RT_NULL;
     }
 
-    // For the demo threads, we assume sensor_thread_init and processing_thread_init
-    // create and start them. To stop them, we'd need their handles.
-    // For simplicity, this example doesn't store their handles to delete them.
-    // A more robust system would store handles from _init functions and delete them.
-    // For now, we'll just detach the message queue if it was for the demo.
-    // Proper cleanup requires deleting/detaching threads that might use the MQ *before* detaching MQ.
-
+    // The demo threads keep running, they idle once the message queue is detached
     if (sensor_data_mq != RT_NULL)
     {
-        rt_kprintf("Detaching DEMO sensor message queue.\n");
-        // Ensure sensor_thread and processing_thread are stopped/deleted first if they are running!
-        // This basic example doesn't track them for deletion properly from main.
-        rt_err_t detach_res = rt_mq_detach(sensor_data_mq);
-        if (detach_res != RT_EOK) {
-            rt_kprintf("Failed to detach sensor_data_mq, error: %d\n", detach_res);
-        }
-        sensor_data_mq = RT_NULL;
+        rt_kprintf("Stopping DEMO.\n");
+        sensor_demo_stop();
     }
-    // To properly stop demo_sensor_thread and demo_processing_thread, you'd need their tids
-    // and delete them here. For instance, if _init functions returned tids:
-    // if(demo_sensor_thread_handle) rt_thread_delete(demo_sensor_thread_handle);
-    // if(demo_processing_thread_handle) rt_thread_delete(demo_processing_thread_handle);
 }
 
 int main(void)
@@ -66,13 +46,7 @@ int main(void)
     rt_kprintf("\n--- RT-Thread Nano DEMO for Nexys A7 ---\n");
     rt_kprintf("System Clock: %d Hz, Tick: %d Hz\n", RT_CPU_CLOCK_HZ, RT_TICK_PER_SECOND);
 
-
-    // Initialize and start the permanent display thread
-    if (display_thread_init() != RT_EOK)
-    {
-        rt_kprintf("FATAL: Failed to initialize display thread. Halting.\n");
-        while(1);
-    }
+    // The permanent display thread is already started by the kernel (RT_THREAD_DEFINE)
 
     rt_uint16_t sw_value = 0xFFFF, last_sw_value = 0xFFFF; // Initialize to ensure first read is processed
 
@@ -97,25 +71,9 @@ int main(void)
 
                 case 1: // Smart Environment DEMO
                     rt_kprintf("SW=1: Starting Smart Environment DEMO...\n");
-                    // Initialize message queue for the demo
-                    if (rt_mq_init(&sensor_data_mq,
-                                   "sensorMQ",
-                                   &sensor_mq_pool[0],
-                                   sizeof(struct sensor_data),
-                                   sizeof(sensor_mq_pool),
-                                   RT_IPC_FLAG_PRIO) != RT_EOK)
-                    {
-                        rt_kprintf("Error: Failed to initialize sensor_data_mq for DEMO.\n");
-                        sensor_data_mq = RT_NULL; // Ensure it's marked as unusable
-                    }
-                    else
-                    {
-                        rt_kprintf("DEMO sensor_data_mq initialized.\n");
-                        // Start demo threads (these functions create & start threads)
-                        // A more robust way would be for _init to return thread handles for later management.
-                        sensor_thread_init();
-                        processing_thread_init();
-                    }
+                    // The message queue and demo threads are statically defined,
+                    // attaching the queue is enough to start the data flow
+                    sensor_demo_start();
                     break;
 
                 case 2: // msgq_sample
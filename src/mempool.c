@@ -25,7 +25,7 @@ static void thread1_mp_alloc(void *parameter)
                线程 1 挂起，转至线程 2 运行 */
             ptr[i] = rt_mp_alloc(&mp, RT_WAITING_FOREVER);
             if (ptr[i] != RT_NULL)
-                rt_kprintf("allocate No.%d\n", i);
+                rt_ktoken_printf("allocate No.%d\n", i);
         }
     }
 }
@@ -41,7 +41,7 @@ static void thread2_mp_release(void *parameter)
         /* 释放所有分配成功的内存块 */
         if (ptr[i] != RT_NULL)
         {
-            rt_kprintf("release block %d\n", i);
+            rt_ktoken_printf("release block %d\n", i);
             rt_mp_free(ptr[i]);
             ptr[i] = RT_NULL;
         }
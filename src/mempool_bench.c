@@ -0,0 +1,58 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+/* 没有 A 扩展时，无锁内存池即关中断的内存池，不作比较 */
+#if defined(RT_USING_MEMPOOL_LOCKFREE) && defined(__riscv_atomic)
+
+#define BENCH_LOOPS         1000
+#define BENCH_BLOCK_SIZE    32
+#define BENCH_BLOCK_COUNT   16
+
+/* 两个相同大小的内存池：关中断链表 和 无锁栈 */
+static rt_uint8_t locked_pool[BENCH_BLOCK_COUNT * (BENCH_BLOCK_SIZE + sizeof(rt_uint8_t *))];
+static rt_uint8_t lockfree_pool[BENCH_BLOCK_COUNT * (BENCH_BLOCK_SIZE + sizeof(rt_uint8_t *))];
+static struct rt_mempool locked_mp;
+static struct rt_mempool lockfree_mp;
+
+/* 测量一次申请 + 释放的平均和最大周期数 */
+static void mempool_bench_run(const char *name, rt_mp_t mp)
+{
+    int i;
+    void *block;
+    rt_uint32_t start, cycles, total = 0, max = 0;
+
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        start = rt_hw_cycle_get();
+        block = rt_mp_alloc(mp, 0);
+        rt_mp_free(block);
+        cycles = rt_hw_cycle_get() - start;
+
+        total += cycles;
+        if (cycles > max)
+            max = cycles;
+    }
+
+    rt_kprintf("%-9s alloc+free: avg %d cycles, max %d cycles\n",
+               name, total / BENCH_LOOPS, max);
+}
+
+int mempool_bench(void)
+{
+    rt_kprintf("\n内存池性能测试 (%d 次)\n", BENCH_LOOPS);
+
+    rt_mp_init(&locked_mp, "mp_lock", locked_pool, sizeof(locked_pool), BENCH_BLOCK_SIZE);
+    rt_mp_init_lockfree(&lockfree_mp, "mp_free", lockfree_pool, sizeof(lockfree_pool), BENCH_BLOCK_SIZE);
+
+    mempool_bench_run("locked", &locked_mp);
+    mempool_bench_run("lock-free", &lockfree_mp);
+
+    rt_mp_detach(&locked_mp);
+    rt_mp_detach(&lockfree_mp);
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(mempool_bench, lock-free mempool benchmark);
+#endif
@@ -0,0 +1,57 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+#ifdef RT_USING_MESSAGEQUEUE
+
+#define BENCH_LOOPS         1000
+#define BENCH_POOL_SIZE     2048
+
+static struct rt_messagequeue bench_mq;
+static rt_uint8_t bench_pool[BENCH_POOL_SIZE];
+static rt_uint8_t bench_msg[64];
+
+/* 测量一种消息大小的队列容量，以及一次发送 + 接收的平均和最大周期数 */
+static void mq_bench_run(rt_size_t msg_size)
+{
+    int i;
+    rt_uint32_t start, cycles, total = 0, max = 0;
+
+    rt_mq_init(&bench_mq, "mq_bench", bench_pool, msg_size, sizeof(bench_pool), RT_IPC_FLAG_FIFO);
+
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        start = rt_hw_cycle_get();
+        rt_mq_send(&bench_mq, bench_msg, msg_size);
+        rt_mq_recv(&bench_mq, bench_msg, msg_size, 0);
+        cycles = rt_hw_cycle_get() - start;
+
+        total += cycles;
+        if (cycles > max)
+            max = cycles;
+    }
+
+    rt_kprintf("msg %2d bytes: %4d msgs in %d bytes, send+recv: avg %d cycles, max %d cycles\n",
+               msg_size, bench_mq.max_msgs, BENCH_POOL_SIZE, total / BENCH_LOOPS, max);
+
+    rt_mq_detach(&bench_mq);
+}
+
+int mq_bench(void)
+{
+#ifdef RT_USING_MESSAGEQUEUE_RING
+    rt_kprintf("\n消息队列性能测试 (环形数组布局, %d 次)\n", BENCH_LOOPS);
+#else
+    rt_kprintf("\n消息队列性能测试 (链表布局, %d 次)\n", BENCH_LOOPS);
+#endif
+
+    mq_bench_run(1);
+    mq_bench_run(4);
+    mq_bench_run(16);
+    mq_bench_run(64);
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(mq_bench, message queue capacity and throughput benchmark);
+#endif
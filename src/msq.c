@@ -19,7 +19,7 @@ static void thread1_entry(void *parameter)
         /* 从消息队列中接收消息 */
         if (rt_mq_recv(&mq, &buf, sizeof(buf), RT_WAITING_FOREVER) == 0)
         {
-            rt_kprintf("thread1: recv msg from msg queue, the content:%c\n", buf);
+            rt_ktoken_printf("thread1: recv msg from msg queue, the content:%c\n", buf);
             if (cnt == 19)
             {
                 break;
@@ -55,7 +55,7 @@ static void thread2_entry(void *parameter)
             }
             else
             {
-                rt_kprintf("thread2: send urgent message - %c\n", buf);
+                rt_ktoken_printf("thread2: send urgent message - %c\n", buf);
             }
         }
         else if (cnt >= 20) /* 发送 20 次消息之后退出 */
@@ -72,7 +72,7 @@ static void thread2_entry(void *parameter)
                 rt_kprintf("rt_mq_send ERR\n");
             }
 
-            rt_kprintf("thread2: send message - %c\n", buf);
+            rt_ktoken_printf("thread2: send message - %c\n", buf);
         }
         buf++;
         cnt++;
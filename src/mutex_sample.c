@@ -34,11 +34,11 @@ static void rt_thread_entry2(void *parameter)
           rt_mutex_take(dynamic_mutex, RT_WAITING_FOREVER);
           if(number1 != number2)
           {
-            rt_kprintf("not protect.number1 = %d, mumber2 = %d \n",number1 ,number2);
+            rt_ktoken_printf("not protect.number1 = %d, mumber2 = %d \n",number1 ,number2);
           }
           else
           {
-            rt_kprintf("mutex protect ,number1 = mumber2 is %d\n",number1);
+            rt_ktoken_printf("mutex protect ,number1 = mumber2 is %d\n",number1);
           }
 
            number1++;
@@ -0,0 +1,107 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+#ifdef RT_USING_SEMAPHORE
+
+#define BENCH_OBJECTS       256
+#define BENCH_LOOPS         4
+
+static struct rt_semaphore bench_sem[BENCH_OBJECTS];
+static char bench_name[BENCH_OBJECTS][RT_NAME_MAX];
+
+/* 原来的做法：在对象链表中逐个比较名字 */
+static rt_object_t object_find_linear(const char *name, rt_uint8_t type)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_object *object;
+
+    information = rt_object_get_information((enum rt_object_class_type)type);
+
+    rt_enter_critical();
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            rt_exit_critical();
+            return object;
+        }
+    }
+    rt_exit_critical();
+
+    return RT_NULL;
+}
+
+/* 查找全部对象的平均周期数 */
+static void object_bench_run(const char *label, rt_object_t (*find)(const char *, rt_uint8_t))
+{
+    int i, loop;
+    rt_uint32_t start, cycles;
+
+    start = rt_hw_cycle_get();
+    for (loop = 0; loop < BENCH_LOOPS; loop++)
+    {
+        for (i = 0; i < BENCH_OBJECTS; i++)
+        {
+            if (find(bench_name[i], RT_Object_Class_Semaphore) != &bench_sem[i].parent.parent)
+                rt_kprintf("%s: %s not found\n", label, bench_name[i]);
+        }
+    }
+    cycles = (rt_hw_cycle_get() - start) / (BENCH_LOOPS * BENCH_OBJECTS);
+    rt_kprintf(" %-8s hit  %8d\n", label, cycles);
+
+    /* 不存在的名字 */
+    start = rt_hw_cycle_get();
+    for (loop = 0; loop < BENCH_LOOPS * BENCH_OBJECTS; loop++)
+        find("nothing", RT_Object_Class_Semaphore);
+    cycles = (rt_hw_cycle_get() - start) / (BENCH_LOOPS * BENCH_OBJECTS);
+    rt_kprintf(" %-8s miss %8d\n", label, cycles);
+}
+
+/* 临时信号量的初始化 + 脱离：有名字的放入对象容器，匿名的不放入 */
+static void object_bench_transient(const char *label, const char *name)
+{
+    int loop;
+    struct rt_semaphore sem;
+    rt_uint32_t start, cycles;
+
+    start = rt_hw_cycle_get();
+    for (loop = 0; loop < BENCH_LOOPS * BENCH_OBJECTS; loop++)
+    {
+        rt_sem_init(&sem, name, 0, RT_IPC_FLAG_FIFO);
+        rt_sem_detach(&sem);
+    }
+    cycles = (rt_hw_cycle_get() - start) / (BENCH_LOOPS * BENCH_OBJECTS);
+    rt_kprintf(" %-9s init+detach %8d\n", label, cycles);
+}
+
+int object_bench(void)
+{
+    int i;
+
+    rt_kprintf("\n按名字查找 %d 个信号量 (单位: 周期)\n", BENCH_OBJECTS);
+
+    for (i = 0; i < BENCH_OBJECTS; i++)
+    {
+        rt_snprintf(bench_name[i], RT_NAME_MAX, "bs%03d", i);
+        rt_sem_init(&bench_sem[i], bench_name[i], 0, RT_IPC_FLAG_FIFO);
+    }
+
+    object_bench_run("linear", object_find_linear);
+    object_bench_run("find", rt_object_find);
+
+    object_bench_transient("named", "tmp");
+    object_bench_transient("anonymous", RT_NULL);
+
+    for (i = 0; i < BENCH_OBJECTS; i++)
+        rt_sem_detach(&bench_sem[i]);
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(object_bench, object lookup by name benchmark);
+#endif
@@ -0,0 +1,142 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+#if defined(RT_USING_PREEMPT_THRESHOLD) && defined(RT_USING_MESSAGEQUEUE) && defined(RT_USING_SEMAPHORE)
+
+#define BENCH_STAGES        3
+#define BENCH_ITEMS         256
+#define BENCH_BURST         8       /* 生产者每批发送的数据个数 */
+#define BENCH_PRIORITY      5       /* 最后一级的优先级，前面每级低一级 */
+#define BENCH_STACK_SIZE    512
+
+static struct rt_thread bench_thread[BENCH_STAGES];
+ALIGN(RT_ALIGN_SIZE)
+static char bench_stack[BENCH_STAGES][BENCH_STACK_SIZE];
+
+static struct rt_messagequeue bench_mq[BENCH_STAGES - 1];
+static rt_uint8_t bench_pool[BENCH_STAGES - 1][BENCH_BURST * 16];
+static struct rt_semaphore bench_done;      /* 最后一级处理完一批 */
+static struct rt_semaphore bench_finish;    /* 全部处理完 */
+
+static int bench_nr_stages;
+static volatile int bench_owner;
+static volatile rt_uint32_t bench_switches;
+static rt_uint32_t bench_start, bench_cycles_total;
+
+/* 每次可能切换的调用之后记下正在运行的阶段，变化一次即一次上下文切换 */
+rt_inline void bench_mark(int stage)
+{
+    if (bench_owner != stage)
+    {
+        bench_owner = stage;
+        bench_switches++;
+    }
+}
+
+/* 第一级产生数据，中间各级转发，最后一级消费 */
+static void bench_stage_entry(void *parameter)
+{
+    int stage = (int)(rt_ubase_t)parameter;
+    int last = bench_nr_stages - 1;
+    rt_uint32_t i, item;
+
+    if (stage == 0)
+    {
+        bench_owner = 0;
+        bench_switches = 0;
+        bench_start = rt_hw_cycle_get();
+    }
+
+    for (i = 0; i < BENCH_ITEMS; i++)
+    {
+        if (stage == 0)
+            item = i;
+        else
+        {
+            rt_mq_recv(&bench_mq[stage - 1], &item, sizeof(item), RT_WAITING_FOREVER);
+            bench_mark(stage);
+        }
+
+        if (stage != last)
+        {
+            rt_mq_send(&bench_mq[stage], &item, sizeof(item));
+            bench_mark(stage);
+        }
+
+        if (item % BENCH_BURST == BENCH_BURST - 1)
+        {
+            /* 一批发送完，等待最后一级处理完 */
+            if (stage == 0)
+            {
+                rt_sem_take(&bench_done, RT_WAITING_FOREVER);
+                bench_mark(stage);
+            }
+            else if (stage == last)
+            {
+                rt_sem_release(&bench_done);
+                bench_mark(stage);
+            }
+        }
+    }
+
+    if (stage == last)
+    {
+        bench_cycles_total = rt_hw_cycle_get() - bench_start;
+        rt_sem_release(&bench_finish);
+    }
+}
+
+/* 运行一次流水线，各级线程的优先级都高于调用者 */
+static void pipe_bench_run(int stages, rt_bool_t threshold)
+{
+    rt_uint8_t priority = BENCH_PRIORITY;
+    int stage;
+
+    bench_nr_stages = stages;
+    for (stage = 0; stage < stages - 1; stage++)
+        rt_mq_init(&bench_mq[stage], RT_NULL, bench_pool[stage], sizeof(rt_uint32_t),
+                   sizeof(bench_pool[stage]), RT_IPC_FLAG_FIFO);
+    rt_sem_init(&bench_done, RT_NULL, 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&bench_finish, RT_NULL, 0, RT_IPC_FLAG_FIFO);
+
+    /* 从最后一级开始启动，让它们先阻塞在接收上 */
+    for (stage = stages - 1; stage >= 0; stage--)
+    {
+        rt_thread_init(&bench_thread[stage], "pipe", bench_stage_entry, (void *)(rt_ubase_t)stage,
+                       bench_stack[stage], BENCH_STACK_SIZE,
+                       BENCH_PRIORITY + stages - 1 - stage, 10);
+        /* 前面各级不被后面的级抢占 */
+        if (threshold)
+            rt_thread_control(&bench_thread[stage], RT_THREAD_CTRL_SET_THRESHOLD, &priority);
+        rt_thread_startup(&bench_thread[stage]);
+    }
+
+    rt_sem_take(&bench_finish, RT_WAITING_FOREVER);
+
+    rt_kprintf(" %d 级 阈值%s: 切换 %4d 次, 每个数据 %6d 周期\n", stages,
+               threshold ? "开" : "关", bench_switches, bench_cycles_total / BENCH_ITEMS);
+
+    for (stage = 0; stage < stages - 1; stage++)
+        rt_mq_detach(&bench_mq[stage]);
+    rt_sem_detach(&bench_done);
+    rt_sem_detach(&bench_finish);
+}
+
+int pipe_bench(void)
+{
+    int stages;
+
+    rt_kprintf("\n生产者/消费者流水线 %d 个数据, 每批 %d 个\n", BENCH_ITEMS, BENCH_BURST);
+
+    for (stages = 2; stages <= BENCH_STAGES; stages++)
+    {
+        pipe_bench_run(stages, RT_FALSE);
+        pipe_bench_run(stages, RT_TRUE);
+    }
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(pipe_bench, preemption threshold pipeline benchmark);
+#endif
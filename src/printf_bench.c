@@ -0,0 +1,58 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+#define BENCH_LOOPS         64
+
+static char bench_buf[64];
+
+/* 各测试项的平均周期数 */
+#define BENCH_RUN(expr)                                     \
+    do                                                      \
+    {                                                       \
+        int i;                                              \
+        rt_uint32_t start = rt_hw_cycle_get();              \
+        for (i = 0; i < BENCH_LOOPS; i++)                   \
+        {                                                   \
+            expr;                                           \
+        }                                                   \
+        cycles = (rt_hw_cycle_get() - start) / BENCH_LOOPS; \
+    } while (0)
+
+int printf_bench(void)
+{
+    rt_uint32_t cycles;
+    volatile float value = 23.456f;
+    volatile double dvalue = 0.1 + 0.2;
+    volatile rt_int32_t number = -1234567;
+
+    rt_kprintf("\nrt_snprintf 性能测试 (单位: 周期)\n");
+
+    /* 整数：两位一组查表转换 */
+    BENCH_RUN(rt_snprintf(bench_buf, sizeof(bench_buf), "%d", number));
+    rt_kprintf(" %%d                %8d\n", cycles);
+    BENCH_RUN(rt_snprintf(bench_buf, sizeof(bench_buf), "%d %u %x",
+                          number, (rt_uint32_t)number, number));
+    rt_kprintf(" %%d %%u %%x          %8d\n", cycles);
+
+    /* 原来的做法：把浮点数拆分为整数和小数部分 */
+    BENCH_RUN(rt_snprintf(bench_buf, sizeof(bench_buf), "%d.%03d",
+                          (int)value, (int)((value - (int)value) * 1000)));
+    rt_kprintf(" %%d.%%03d (拆分)     %8d\n", cycles);
+
+    /* 浮点数：指定精度 */
+    BENCH_RUN(rt_snprintf(bench_buf, sizeof(bench_buf), "%.3f", value));
+    rt_kprintf(" %%.3f              %8d\n", cycles);
+    BENCH_RUN(rt_snprintf(bench_buf, sizeof(bench_buf), "%.6e", dvalue));
+    rt_kprintf(" %%.6e              %8d\n", cycles);
+
+    /* 浮点数：最短且能还原的表示 */
+    BENCH_RUN(rt_snprintf(bench_buf, sizeof(bench_buf), "%g", value));
+    rt_kprintf(" %%g (float)        %8d  %s\n", cycles, bench_buf);
+    BENCH_RUN(rt_snprintf(bench_buf, sizeof(bench_buf), "%g", dvalue));
+    rt_kprintf(" %%g (double)       %8d  %s\n", cycles, bench_buf);
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(printf_bench, rt_snprintf integer and floating point benchmark);
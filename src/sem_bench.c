@@ -0,0 +1,71 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+#ifdef RT_USING_SEMAPHORE
+
+#define BENCH_LOOPS         1000
+#define BENCH_PRIORITY      5       /* 高于调用者，释放信号量时被唤醒并立即运行 */
+#define BENCH_STACK_SIZE    512
+
+static struct rt_thread pong_thread;
+ALIGN(RT_ALIGN_SIZE)
+static char pong_stack[BENCH_STACK_SIZE];
+
+static struct rt_semaphore ping_sem;
+static struct rt_semaphore pong_sem;
+
+/* 收到 ping 后立即回 pong */
+static void pong_entry(void *parameter)
+{
+    int i;
+
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        rt_sem_take(&ping_sem, RT_WAITING_FOREVER);
+        rt_sem_release(&pong_sem);
+    }
+}
+
+/* 测量一次 ping + pong 往返的平均和最大周期数 */
+int sem_bench(void)
+{
+    int i;
+    rt_uint32_t start, cycles, total = 0, max = 0;
+
+#ifdef RT_USING_IPC_HANDOFF
+    rt_kprintf("\n信号量往返延迟测试 (直接切换, %d 次)\n", BENCH_LOOPS);
+#else
+    rt_kprintf("\n信号量往返延迟测试 (通用调度, %d 次)\n", BENCH_LOOPS);
+#endif
+
+    rt_sem_init(&ping_sem, RT_NULL, 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&pong_sem, RT_NULL, 0, RT_IPC_FLAG_FIFO);
+
+    /* pong 线程先运行并阻塞在 ping 上 */
+    rt_thread_init(&pong_thread, "pong", pong_entry, RT_NULL,
+                   pong_stack, BENCH_STACK_SIZE, BENCH_PRIORITY, 10);
+    rt_thread_startup(&pong_thread);
+
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        start = rt_hw_cycle_get();
+        rt_sem_release(&ping_sem);
+        rt_sem_take(&pong_sem, RT_WAITING_FOREVER);
+        cycles = rt_hw_cycle_get() - start;
+
+        total += cycles;
+        if (cycles > max)
+            max = cycles;
+    }
+
+    rt_kprintf("ping + pong: avg %d cycles, max %d cycles\n", total / BENCH_LOOPS, max);
+
+    rt_sem_detach(&ping_sem);
+    rt_sem_detach(&pong_sem);
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(sem_bench, semaphore ping-pong latency benchmark);
+#endif
@@ -0,0 +1,79 @@
+#include <rtthread.h>
+#include <rthw.h>
+
+#define BENCH_LOOPS         16
+#define BENCH_MAX_SIZE      4096
+
+ALIGN(RT_ALIGN_SIZE)
+static char bench_src[BENCH_MAX_SIZE + 8];
+ALIGN(RT_ALIGN_SIZE)
+static char bench_dst[BENCH_MAX_SIZE + 8];
+
+/* 测试的数据长度：1 B 到 4 KB */
+static const rt_uint16_t bench_sizes[] = {1, 4, 16, 64, 256, 1024, 4096};
+
+/* 各测试项的平均周期数 */
+#define BENCH_RUN(expr)                                     \
+    do                                                      \
+    {                                                       \
+        int i;                                              \
+        rt_uint32_t start = rt_hw_cycle_get();              \
+        for (i = 0; i < BENCH_LOOPS; i++)                   \
+        {                                                   \
+            expr;                                           \
+        }                                                   \
+        cycles = (rt_hw_cycle_get() - start) / BENCH_LOOPS; \
+    } while (0)
+
+int string_bench(void)
+{
+    rt_uint32_t cycles;
+    rt_uint32_t index;
+    rt_size_t size;
+
+    /* 结果逐项输出，条数超过异步 rt_kprintf 的缓冲，改为直接输出 */
+    rt_kprintf_sync(RT_TRUE);
+
+#ifdef __riscv_zbb
+    rt_kprintf("\n内存与字符串函数性能测试 (Zbb, 单位: 周期)\n");
+#else
+    rt_kprintf("\n内存与字符串函数性能测试 (单位: 周期)\n");
+#endif
+    rt_kprintf(" size   memcpy  memcpy+1  memmove   memcmp   strlen  strncmp\n");
+
+    for (index = 0; index < sizeof(bench_sizes) / sizeof(bench_sizes[0]); index++)
+    {
+        size = bench_sizes[index];
+
+        /* 两个相同的字符串，长度为 size */
+        rt_memset(bench_src, 'a', sizeof(bench_src));
+        bench_src[size] = '\0';
+        rt_memcpy(bench_dst, bench_src, sizeof(bench_dst));
+
+        rt_kprintf("%5d", size);
+
+        /* 对齐拷贝、源地址不对齐的拷贝、重叠的后向拷贝 */
+        BENCH_RUN(rt_memcpy(bench_dst, bench_src, size));
+        rt_kprintf(" %8d", cycles);
+        BENCH_RUN(rt_memcpy(bench_dst, bench_src + 1, size));
+        rt_kprintf(" %9d", cycles);
+        BENCH_RUN(rt_memmove(bench_dst + 3, bench_dst, size));
+        rt_kprintf(" %8d", cycles);
+
+        /* 恢复相同的内容后比较 */
+        rt_memcpy(bench_dst, bench_src, sizeof(bench_dst));
+        BENCH_RUN(rt_memcmp(bench_dst, bench_src, size));
+        rt_kprintf(" %8d", cycles);
+        BENCH_RUN(rt_strlen(bench_src));
+        rt_kprintf(" %8d", cycles);
+        BENCH_RUN(rt_strncmp(bench_dst, bench_src, size + 1));
+        rt_kprintf(" %8d\n", cycles);
+    }
+
+    rt_kprintf_sync(RT_FALSE);
+
+    return 0;
+}
+
+/* 导出到 msh 命令列表中 */
+MSH_CMD_EXPORT(string_bench, memory and string function benchmark);
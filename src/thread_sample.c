@@ -14,7 +14,7 @@ static void thread1_entry(void *parameter)
     while (count < 100)
     {
         /* 线程 1 采用低优先级运行，一直打印计数值 */
-        rt_kprintf("thread1 count: %d\n", count++);
+        rt_ktoken_printf("thread1 count: %d\n", count++);
         rt_thread_mdelay(2000);
     }
 }
@@ -31,7 +31,7 @@ static void thread2_entry(void *param)
     for (count = 0; count < 10; count++)
     {
         /* 线程 2 打印计数值 */
-        rt_kprintf("thread2 count: %d\n", count);
+        rt_ktoken_printf("thread2 count: %d\n", count);
     }
     rt_kprintf("thread2 exit\n");
     /* 线程 2 运行结束后也将自动被系统脱离 */
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * The minimal kernel services needed to run the heap allocators
+ * (mem.c, slab.c, memheap.c) as a single-threaded Linux program.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include <rtthread.h>
+#include <rthw.h>
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+}
+
+void rt_enter_critical(void)
+{
+}
+
+void rt_exit_critical(void)
+{
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    return RT_NULL;
+}
+
+rt_uint8_t rt_interrupt_get_nest(void)
+{
+    return 0;
+}
+
+void rt_object_init(struct rt_object *object,
+                    enum rt_object_class_type type,
+                    const char *name)
+{
+    object->type = type | RT_Object_Class_Static;
+    snprintf(object->name, RT_NAME_MAX, "%s", name);
+}
+
+void rt_object_detach(rt_object_t object)
+{
+    object->type = 0;
+}
+
+rt_uint8_t rt_object_get_type(rt_object_t object)
+{
+    return object->type & ~RT_Object_Class_Static;
+}
+
+struct rt_object_information *rt_object_get_information(enum rt_object_class_type type)
+{
+    static struct rt_object_information info;
+
+    /* no other memory heap on host */
+    info.type = type;
+    info.object_list.next = info.object_list.prev = &info.object_list;
+
+    return &info;
+}
+
+/* single-threaded: a semaphore is a counter which must never block */
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    rt_object_init(&sem->parent.parent, RT_Object_Class_Semaphore, name);
+    sem->value = value;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem)
+{
+    rt_object_detach(&sem->parent.parent);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    if (sem->value == 0)
+    {
+        fprintf(stderr, "semaphore %.*s would block\n", RT_NAME_MAX, sem->parent.parent.name);
+        abort();
+    }
+    sem->value --;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    sem->value ++;
+
+    return RT_EOK;
+}
+
+void rt_set_errno(rt_err_t error)
+{
+}
+
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    return memset(s, c, count);
+}
+
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    return memcpy(dst, src, count);
+}
+
+char *rt_strncpy(char *dst, const char *src, rt_ubase_t n)
+{
+    return strncpy(dst, src, n);
+}
+
+void rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line)
+{
+    fprintf(stderr, "(%s) assertion failed at function:%s, line number:%d\n",
+            ex, func, (int)line);
+    abort();
+}
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * Page allocator fragmentation benchmark.
+ *
+ * Replays the same random alloc/free trace against the buddy page allocator
+ * of slab.c and against the former first-fit page list, then reports failed
+ * allocations, the average external fragmentation (1 - largest free block /
+ * free pages) and the cost of each operation, the best of a few passes.
+ * The cost of the page list grows with the number of free runs, that of the
+ * buddy allocator is bounded by the number of orders.
+ *
+ * usage: page_frag [pages] [operations] [seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <rtthread.h>
+
+#define HEAP_PAGES_DEFAULT  1024
+#define TRACE_OPS_DEFAULT   200000
+#define TRACE_LIVE_MAX      4096
+#define TIMED_PASSES        5
+
+/* the page list allocator used by slab.c before the buddy allocator */
+struct list_page_head
+{
+    struct list_page_head *next;
+    rt_size_t page;
+    char dummy[RT_MM_PAGE_SIZE - (sizeof(struct list_page_head *) + sizeof(rt_size_t))];
+};
+static struct list_page_head *list_page_list;
+
+static void *list_page_alloc(rt_size_t npages)
+{
+    struct list_page_head *b, *n;
+    struct list_page_head **prev;
+
+    for (prev = &list_page_list; (b = *prev) != RT_NULL; prev = &(b->next))
+    {
+        if (b->page > npages)
+        {
+            n       = b + npages;
+            n->next = b->next;
+            n->page = b->page - npages;
+            *prev   = n;
+            break;
+        }
+
+        if (b->page == npages)
+        {
+            *prev = b->next;
+            break;
+        }
+    }
+
+    return b;
+}
+
+static void list_page_free(void *addr, rt_size_t npages)
+{
+    struct list_page_head *b, *n;
+    struct list_page_head **prev;
+
+    n = (struct list_page_head *)addr;
+    for (prev = &list_page_list; (b = *prev) != RT_NULL; prev = &(b->next))
+    {
+        if (b + b->page == n)
+        {
+            if (b + (b->page += npages) == b->next)
+            {
+                b->page += b->next->page;
+                b->next  = b->next->next;
+            }
+            return;
+        }
+
+        if (b == n + npages)
+        {
+            n->page = b->page + npages;
+            n->next = b->next;
+            *prev   = n;
+            return;
+        }
+
+        if (b > n + npages)
+            break;
+    }
+
+    n->page = npages;
+    n->next = b;
+    *prev   = n;
+}
+
+static void list_page_info(rt_uint32_t *free, rt_uint32_t *max_free)
+{
+    struct list_page_head *b;
+
+    *free = *max_free = 0;
+    for (b = list_page_list; b != RT_NULL; b = b->next)
+    {
+        *free += b->page;
+        if (b->page > *max_free)
+            *max_free = b->page;
+    }
+}
+
+static void buddy_page_info(rt_uint32_t *free, rt_uint32_t *max_free)
+{
+    rt_page_info(RT_NULL, free, max_free);
+}
+
+/* trace operation: npages > 0 allocates slot, npages == 0 frees slot */
+struct trace_op
+{
+    int slot;
+    int npages;
+};
+
+struct page_allocator
+{
+    const char *name;
+    void *(*alloc)(rt_size_t npages);
+    void (*free)(void *addr, rt_size_t npages);
+    void (*info)(rt_uint32_t *free, rt_uint32_t *max_free);
+};
+
+static int trace_size(void)
+{
+    int r = rand() % 100;
+
+    /* slab zones (32KB) and large allocations above the zone limit (8KB) */
+    if (r < 50) return 8;
+    if (r < 85) return 2 + rand() % 7;
+    if (r < 97) return 9 + rand() % 24;
+    return 33 + rand() % 32;
+}
+
+static struct trace_op *trace_build(int ops, int pages)
+{
+    struct trace_op *trace = malloc(sizeof(struct trace_op) * ops);
+    int live_size[TRACE_LIVE_MAX] = {0};
+    int live_slot[TRACE_LIVE_MAX];
+    int live = 0, used = 0, i;
+
+    for (i = 0; i < ops; i ++)
+    {
+        int npages = trace_size();
+
+        /* keep the demand around 80% of heap */
+        if (live > 0 && (used + npages > pages * 8 / 10 || live == TRACE_LIVE_MAX || rand() % 2))
+        {
+            int k = rand() % live;
+            int slot = live_slot[k];
+
+            trace[i].slot   = slot;
+            trace[i].npages = 0;
+            used -= live_size[slot];
+            live_size[slot] = 0;
+            live_slot[k] = live_slot[--live];
+        }
+        else
+        {
+            int slot;
+
+            for (slot = 0; live_size[slot] != 0; slot ++) ;
+            trace[i].slot   = slot;
+            trace[i].npages = npages;
+            used += npages;
+            live_size[slot] = npages;
+            live_slot[live++] = slot;
+        }
+    }
+
+    return trace;
+}
+
+/* replay trace, sample fragmentation when stats is set */
+static double trace_replay(const struct page_allocator *a, const struct trace_op *trace, int ops,
+                           int *fail, double *frag)
+{
+    static void *addr[TRACE_LIVE_MAX];
+    static int size[TRACE_LIVE_MAX];
+    struct timespec t0, t1;
+    int samples = 0, i;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < ops; i ++)
+    {
+        const struct trace_op *op = &trace[i];
+
+        if (op->npages)
+        {
+            addr[op->slot] = a->alloc(op->npages);
+            size[op->slot] = op->npages;
+            if (addr[op->slot] == RT_NULL && fail)
+                (*fail) ++;
+        }
+        else if (addr[op->slot] != RT_NULL)
+        {
+            a->free(addr[op->slot], size[op->slot]);
+            addr[op->slot] = RT_NULL;
+        }
+
+        if (frag && i % 64 == 0)
+        {
+            rt_uint32_t free, max_free;
+
+            a->info(&free, &max_free);
+            if (free)
+            {
+                *frag += 1.0 - (double)max_free / free;
+                samples ++;
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* release all of live blocks */
+    for (i = 0; i < TRACE_LIVE_MAX; i ++)
+    {
+        if (addr[i] != RT_NULL)
+        {
+            a->free(addr[i], size[i]);
+            addr[i] = RT_NULL;
+        }
+    }
+
+    if (frag && samples)
+        *frag = *frag * 100 / samples;
+
+    return ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / ops;
+}
+
+static void trace_run(const struct page_allocator *a, const struct trace_op *trace, int ops)
+{
+    int fail = 0, i;
+    double frag = 0, ns = 0, best;
+
+    /* the timed passes do not sample fragmentation, the fastest is taken */
+    for (i = 0; i < TIMED_PASSES; i ++)
+    {
+        best = trace_replay(a, trace, ops, RT_NULL, RT_NULL);
+        if (i == 0 || best < ns)
+            ns = best;
+    }
+    trace_replay(a, trace, ops, &fail, &frag);
+
+    printf("%-10s %10d %13.1f%% %12.1f\n", a->name, fail, frag, ns);
+}
+
+int main(int argc, char **argv)
+{
+    int pages = argc > 1 ? atoi(argv[1]) : HEAP_PAGES_DEFAULT;
+    int ops   = argc > 2 ? atoi(argv[2]) : TRACE_OPS_DEFAULT;
+    int seed  = argc > 3 ? atoi(argv[3]) : 1;
+    struct trace_op *trace;
+    rt_uint8_t *heap, *list_heap;
+    rt_uint32_t total;
+    const struct page_allocator buddy = {"buddy", rt_page_alloc, rt_page_free, buddy_page_info};
+    const struct page_allocator list  = {"list", list_page_alloc, list_page_free, list_page_info};
+
+    /* the page allocator of slab.c manages the system heap */
+    heap = aligned_alloc(RT_MM_PAGE_SIZE, (rt_size_t)pages * RT_MM_PAGE_SIZE);
+    rt_system_heap_init(heap, heap + (rt_size_t)pages * RT_MM_PAGE_SIZE);
+    rt_page_info(RT_NULL, &total, RT_NULL);
+
+    /* give the same number of free pages to page list */
+    list_heap = aligned_alloc(RT_MM_PAGE_SIZE, (rt_size_t)pages * RT_MM_PAGE_SIZE);
+    list_page_list = RT_NULL;
+    list_page_free(list_heap, total);
+
+    srand(seed);
+    trace = trace_build(ops, total);
+
+    printf("%d free pages, %d operations, seed %d\n", (int)total, ops, seed);
+    printf("%-10s %10s %14s %12s\n", "allocator", "failures", "fragmentation", "ns/op");
+    trace_run(&list, trace, ops);
+    trace_run(&buddy, trace, ops);
+
+    free(trace);
+    free(list_heap);
+    free(heap);
+
+    return 0;
+}
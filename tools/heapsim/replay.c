@@ -0,0 +1,543 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * Heap allocation trace replay.
+ *
+ * Replays a trace dumped by the memrecord shell command against one heap
+ * backend (this file is linked with mem.c, slab.c or memheap.c) and reports
+ * the latency percentiles of rt_malloc/rt_free, the peak footprint and the
+ * external fragmentation (1 - largest allocatable block / free memory),
+ * sampled along the trace.
+ *
+ * Without a trace file, a synthetic workload of thread stacks, long-lived
+ * objects and short-lived messages is generated from the seed. The default
+ * heap holds it in each backend: slab.c takes a zone of 32 to 128 KB for
+ * each size class in use, far more than the live data of about 50 KB.
+ *
+ * The latencies are of the successful calls. The failed allocations, and
+ * the releases of blocks whose allocation failed or was not recorded, are
+ * counted apart; many of them mean the heap is too small for the trace.
+ *
+ * usage: replay [-H heap_size] [-n operations] [-s seed] [trace]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include <rtthread.h>
+
+#if defined(RT_USING_SLAB)
+#define BACKEND_NAME        "slab.c"
+#elif defined(RT_USING_MEMHEAP_AS_HEAP)
+#define BACKEND_NAME        "memheap.c"
+#else
+#define BACKEND_NAME        "mem.c"
+#endif
+
+#define HEAP_SIZE_DEFAULT   (1024 * 1024)
+#define TRACE_OPS_DEFAULT   20000
+#define FRAG_SAMPLES        256
+#define THREAD_MAX          32
+
+struct trace_item
+{
+    unsigned long timestamp;
+    unsigned long thread;
+    unsigned long ptr;
+    unsigned long size;
+};
+
+struct thread_item
+{
+    unsigned long thread;
+    char name[RT_NAME_MAX + 1];
+    unsigned long allocs;
+    unsigned long bytes;
+};
+
+/* the heap usage at a sample point of fragmentation */
+struct frag_sample
+{
+    unsigned long used;
+    unsigned long free_size;
+    unsigned long largest;
+};
+
+/* the live allocations, keyed by the block address in trace */
+struct live_item
+{
+    unsigned long ptr;
+    void *block;
+};
+
+static struct trace_item *trace;
+static rt_size_t trace_count, trace_max;
+
+static struct thread_item threads[THREAD_MAX];
+static int thread_count;
+
+static struct live_item *live;
+static rt_size_t live_mask;
+
+static double *malloc_ns, *free_ns;
+static rt_size_t malloc_count, free_count, live_count;
+static rt_size_t failed, unmatched;
+
+#ifdef RT_USING_SLAB
+/* the memory held by slab is the pages of zones and large blocks */
+static rt_size_t page_peak;
+#endif
+
+static struct frag_sample *frag;
+static rt_size_t frag_count, frag_interval;
+
+static void trace_add(unsigned long timestamp, unsigned long thread,
+                      unsigned long ptr, unsigned long size)
+{
+    if (trace_count == trace_max)
+    {
+        trace_max = trace_max ? trace_max * 2 : 4096;
+        trace = realloc(trace, trace_max * sizeof(struct trace_item));
+        if (trace == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+
+    trace[trace_count].timestamp = timestamp;
+    trace[trace_count].thread    = thread;
+    trace[trace_count].ptr       = ptr;
+    trace[trace_count].size      = size;
+    trace_count ++;
+}
+
+static struct thread_item *thread_get(unsigned long thread)
+{
+    int index;
+
+    for (index = 0; index < thread_count; index ++)
+    {
+        if (threads[index].thread == thread)
+            return &threads[index];
+    }
+
+    if (thread_count == THREAD_MAX)
+        return NULL;
+
+    threads[thread_count].thread = thread;
+    snprintf(threads[thread_count].name, sizeof(threads[0].name),
+             thread ? "%08lx" : "-", thread);
+
+    return &threads[thread_count ++];
+}
+
+static int trace_load(const char *path)
+{
+    FILE *fp;
+    char line[128];
+    unsigned long w[4];
+    char name[RT_NAME_MAX + 1];
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (line[0] == 'T' && line[1] == ' ')
+        {
+            struct thread_item *item;
+
+            name[0] = '\0';
+            if (sscanf(line + 2, "%lx %8s", &w[0], name) >= 1 &&
+                (item = thread_get(w[0])) != NULL)
+            {
+                strcpy(item->name, name);
+            }
+        }
+        else if (sscanf(line, "%lx %lx %lx %lx", &w[0], &w[1], &w[2], &w[3]) == 4)
+        {
+            trace_add(w[0], w[1], w[2], w[3]);
+        }
+        /* the other lines of console log are ignored */
+    }
+    fclose(fp);
+
+    return 0;
+}
+
+/* a workload of thread stacks, long-lived objects and short-lived messages */
+static void trace_generate(rt_size_t ops, unsigned int seed)
+{
+    unsigned long *alive;
+    rt_size_t alive_count = 0, next_ptr = 1, tick = 0;
+
+    srand(seed);
+    alive = calloc(ops, sizeof(unsigned long));
+
+    while (trace_count < ops)
+    {
+        unsigned long size;
+        int kind = rand() % 100;
+
+        tick += rand() % 4;
+        if (alive_count > 0 && (kind < 45 || alive_count > 160))
+        {
+            rt_size_t index;
+
+            /* release the young blocks more often than the old ones */
+            if (rand() % 8 == 0 || alive_count < 8)
+                index = rand() % alive_count;
+            else
+                index = alive_count - 1 - rand() % 8;
+
+            trace_add(tick, 1 + alive[index] % 3, alive[index] << 4, 0);
+            alive[index] = alive[-- alive_count];
+            continue;
+        }
+
+        if (kind < 50)
+            size = 512 + (rand() % 4) * 512;    /* thread stack */
+        else if (kind < 65)
+            size = 64 + rand() % 192;           /* control block and object */
+        else
+            size = 8 + rand() % 120;            /* message */
+
+        alive[alive_count ++] = next_ptr;
+        trace_add(tick, 1 + next_ptr % 3, next_ptr << 4, size);
+        next_ptr ++;
+    }
+
+    free(alive);
+}
+
+static struct live_item *live_find(unsigned long ptr, int insert)
+{
+    rt_size_t index = (ptr >> 3) * 2654435761u;
+
+    for (index &= live_mask; ; index = (index + 1) & live_mask)
+    {
+        if (live[index].ptr == ptr)
+            return &live[index];
+        if (live[index].ptr == 0)
+            return insert ? &live[index] : NULL;
+    }
+}
+
+static void live_remove(struct live_item *item)
+{
+    rt_size_t index = item - live, next;
+
+    /* backward shift deletion keeps the probe sequences intact */
+    item->ptr = 0;
+    for (next = (index + 1) & live_mask; live[next].ptr != 0; next = (next + 1) & live_mask)
+    {
+        rt_size_t home = ((live[next].ptr >> 3) * 2654435761u) & live_mask;
+
+        if (((next - home) & live_mask) >= ((next - index) & live_mask))
+        {
+            live[index] = live[next];
+            live[next].ptr = 0;
+            index = next;
+        }
+    }
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* the largest block which can be allocated right now */
+static rt_size_t largest_block(rt_size_t limit)
+{
+    rt_size_t low = 0, high = limit;
+
+    while (low < high)
+    {
+        rt_size_t mid = (low + high + 1) / 2;
+        void *ptr = rt_malloc(mid);
+
+        if (ptr != RT_NULL)
+        {
+            rt_free(ptr);
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    return low;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void print_latency(const char *name, double *ns, rt_size_t count)
+{
+    if (count == 0)
+    {
+        printf("%-6s latency ns: no operation\n", name);
+        return;
+    }
+
+    qsort(ns, count, sizeof(double), cmp_double);
+    printf("%-6s latency ns: p50 %6.0f  p90 %6.0f  p99 %6.0f  p99.9 %6.0f  max %7.0f\n",
+           name, ns[count / 2], ns[count * 90 / 100], ns[count * 99 / 100],
+           ns[count * 999 / 1000], ns[count - 1]);
+}
+
+/*
+ * The probes of largest_block() change the state of allocator, so each sample
+ * is taken in a forked copy of the process, and the timed replay runs in a
+ * process which has never been probed.
+ */
+static void frag_sample_take(void)
+{
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        struct frag_sample *sample = &frag[frag_count];
+        rt_uint32_t total, used;
+
+        rt_memory_info(&total, &used, RT_NULL);
+        sample->used      = used;
+        sample->free_size = total - used;
+        sample->largest   = largest_block(total - used);
+        _exit(0);
+    }
+    else if (pid > 0)
+    {
+        waitpid(pid, NULL, 0);
+        frag_count ++;
+    }
+}
+
+static void replay(rt_uint8_t *heap, rt_size_t heap_size, int sampling)
+{
+    rt_size_t index;
+    double t0, elapsed;
+
+    rt_system_heap_init(heap, heap + heap_size);
+
+    for (index = 0; index < trace_count; index ++)
+    {
+        struct trace_item *op = &trace[index];
+        struct live_item *item;
+
+        if (sampling && index % frag_interval == 0)
+            frag_sample_take();
+
+        if (op->size != 0)
+        {
+            struct thread_item *thread = thread_get(op->thread);
+            void *block;
+
+            t0 = now_ns();
+            block = rt_malloc(op->size);
+            elapsed = now_ns() - t0;
+
+            if (thread != NULL)
+            {
+                thread->allocs ++;
+                thread->bytes += op->size;
+            }
+
+            if (block == RT_NULL)
+            {
+                failed ++;
+                goto __next;
+            }
+            malloc_ns[malloc_count ++] = elapsed;
+
+            item = live_find(op->ptr, 1);
+            if (item->ptr != 0)
+            {
+                /* the recorder missed the release of this address */
+                rt_free(item->block);
+                live_count --;
+            }
+            item->ptr   = op->ptr;
+            item->block = block;
+            live_count ++;
+        }
+        else
+        {
+            item = live_find(op->ptr, 0);
+            if (item == NULL)
+            {
+                /* allocated before recording, or the allocation failed */
+                unmatched ++;
+                goto __next;
+            }
+
+            t0 = now_ns();
+            rt_free(item->block);
+            free_ns[free_count ++] = now_ns() - t0;
+
+            live_remove(item);
+            live_count --;
+        }
+
+__next:
+#ifdef RT_USING_SLAB
+        {
+            rt_uint32_t total, free_pages;
+
+            rt_page_info(&total, &free_pages, RT_NULL);
+            if (page_peak < total - free_pages)
+                page_peak = total - free_pages;
+        }
+#endif
+    }
+}
+
+int main(int argc, char **argv)
+{
+    rt_size_t heap_size = HEAP_SIZE_DEFAULT, ops = TRACE_OPS_DEFAULT;
+    unsigned int seed = 1;
+    const char *path = NULL;
+    rt_uint8_t *heap;
+    rt_uint32_t total, used, max_used;
+    rt_size_t index, peak = 0;
+    double frag_sum = 0;
+    pid_t pid;
+    int opt;
+
+    for (opt = 1; opt < argc; opt ++)
+    {
+        if (!strcmp(argv[opt], "-H") && opt + 1 < argc)
+            heap_size = strtoul(argv[++ opt], NULL, 0);
+        else if (!strcmp(argv[opt], "-n") && opt + 1 < argc)
+            ops = strtoul(argv[++ opt], NULL, 0);
+        else if (!strcmp(argv[opt], "-s") && opt + 1 < argc)
+            seed = strtoul(argv[++ opt], NULL, 0);
+        else if (argv[opt][0] != '-')
+            path = argv[opt];
+        else
+        {
+            fprintf(stderr, "usage: %s [-H heap_size] [-n operations] [-s seed] [trace]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (path != NULL)
+    {
+        if (trace_load(path) < 0)
+            return 1;
+    }
+    else
+    {
+        trace_generate(ops, seed);
+    }
+
+    for (live_mask = 1024; live_mask < trace_count * 2; live_mask <<= 1);
+    live = calloc(live_mask, sizeof(struct live_item));
+    live_mask -= 1;
+
+    malloc_ns = malloc((trace_count + 1) * sizeof(double));
+    free_ns   = malloc((trace_count + 1) * sizeof(double));
+    heap      = aligned_alloc(RT_MM_PAGE_SIZE, RT_ALIGN(heap_size, RT_MM_PAGE_SIZE));
+    frag      = mmap(NULL, FRAG_SAMPLES * sizeof(struct frag_sample),
+                     PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (live == NULL || malloc_ns == NULL || free_ns == NULL || heap == NULL || frag == MAP_FAILED)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    frag_interval = (trace_count + FRAG_SAMPLES - 1) / FRAG_SAMPLES;
+    if (frag_interval == 0) frag_interval = 1;
+
+    /* the sampling pass, in a child process */
+    pid = fork();
+    if (pid == 0)
+    {
+        replay(heap, heap_size, 1);
+        _exit(0);
+    }
+    else if (pid > 0)
+    {
+        waitpid(pid, NULL, 0);
+        frag_count = (trace_count + frag_interval - 1) / frag_interval;
+    }
+
+    /* the timed pass */
+    replay(heap, heap_size, 0);
+    rt_memory_info(&total, &used, &max_used);
+
+    for (index = 0; index < frag_count; index ++)
+    {
+        double ratio = frag[index].free_size ?
+                       1.0 - (double)frag[index].largest / frag[index].free_size : 0;
+
+        frag_sum += ratio;
+        if (frag[index].used >= frag[peak].used)
+            peak = index;
+    }
+
+    printf("backend: %s, heap %lu bytes, trace %lu operations\n", BACKEND_NAME,
+           (unsigned long)total, (unsigned long)trace_count);
+    printf("malloc %lu, free %lu, live at end %lu\n", (unsigned long)malloc_count,
+           (unsigned long)free_count, (unsigned long)live_count);
+    printf("failed malloc %lu (%.1f%%), free without block %lu\n", (unsigned long)failed,
+           100.0 * failed / ((malloc_count + failed) ? malloc_count + failed : 1),
+           (unsigned long)unmatched);
+    if (failed * 100 > malloc_count + failed)
+        printf("warning: more than 1%% of malloc failed, try a larger heap (-H)\n");
+    print_latency("malloc", malloc_ns, malloc_count);
+    print_latency("free", free_ns, free_count);
+    printf("peak footprint: %lu bytes (%.1f%% of heap)\n",
+           (unsigned long)max_used, total ? 100.0 * max_used / total : 0);
+#ifdef RT_USING_SLAB
+    printf("peak page footprint: %lu pages (%.1f%% of heap)\n",
+           (unsigned long)page_peak, 100.0 * page_peak * RT_MM_PAGE_SIZE / total);
+#endif
+    if (frag_count > 0)
+    {
+        printf("fragmentation: average %.1f%%, at highest sampled usage %.1f%% (%lu samples)\n",
+               100.0 * frag_sum / frag_count,
+               frag[peak].free_size ? 100.0 - 100.0 * frag[peak].largest / frag[peak].free_size : 0,
+               (unsigned long)frag_count);
+    }
+
+    if (path != NULL)
+    {
+        printf("thread    allocs    bytes\n");
+        for (opt = 0; opt < thread_count; opt ++)
+        {
+            if (threads[opt].allocs == 0) continue;
+            printf("%-8s %7lu %8lu\n", threads[opt].name, threads[opt].allocs, threads[opt].bytes);
+        }
+    }
+
+    return 0;
+}
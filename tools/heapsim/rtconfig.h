@@ -0,0 +1,21 @@
+/* RT-Thread config file for the host heap simulator */
+#ifndef __RTTHREAD_CFG_H__
+#define __RTTHREAD_CFG_H__
+
+#define RT_NAME_MAX         8
+#define RT_ALIGN_SIZE       8
+#define RT_THREAD_PRIORITY_MAX  32
+#define RT_TICK_PER_SECOND  1000
+
+/* use the host C library va_list */
+#define RT_USING_NEWLIB
+
+#define RT_USING_CONSOLE
+#define RT_USING_SEMAPHORE
+#define RT_USING_HEAP
+
+/* the heap backend is selected by the Makefile:
+ * RT_USING_SMALL_MEM, RT_USING_SLAB or RT_USING_MEMHEAP_AS_HEAP
+ */
+
+#endif
@@ -0,0 +1,566 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * Tokenized log decoder.
+ *
+ * Reads the formats from the rt_ktoken section of the firmware ELF file,
+ * then copies the console output to stdout, replacing each "$base64" record
+ * printed by rt_ktoken_printf() with its formatted text. The other console
+ * output passes through unchanged.
+ *
+ * The token of a record is the offset of its entry in the section divided
+ * by 4. An entry is the argument types in 32 bits, then the format string.
+ *
+ * A format without precision prints floating point numbers in the shortest
+ * digits, as rt_vsnprintf does on target. The arguments left out of a
+ * record which did not fit the buffer of encoder are printed as '?'.
+ *
+ * With -s, a summary of the records, their size and the size of the text
+ * they stand for is printed to stderr at the end.
+ *
+ * usage: ktoken [-s] firmware.elf [log]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <elf.h>
+
+#define SECTION_NAME        "rt_ktoken"
+#define RECORD_MAX          1024
+
+/* the content of rt_ktoken section */
+static char *tokens;
+static size_t tokens_size;
+
+/* the summary */
+static unsigned long record_count, record_bad;
+static unsigned long console_bytes, text_bytes;
+
+static void *load_file(const char *name, size_t *size)
+{
+    FILE *fp;
+    char *data;
+    long length;
+
+    fp = fopen(name, "rb");
+    if (fp == NULL)
+        return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    data = malloc(length + 1);
+    if (data != NULL && fread(data, 1, length, fp) != (size_t)length)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(fp);
+
+    *size = length;
+    return data;
+}
+
+/* find the section in an ELF32 or ELF64 little endian file */
+static int load_tokens(const char *name)
+{
+    unsigned char *elf;
+    size_t size, offset = 0, length = 0;
+    int index;
+
+    elf = load_file(name, &size);
+    if (elf == NULL || size < EI_NIDENT || memcmp(elf, ELFMAG, SELFMAG) ||
+        elf[EI_DATA] != ELFDATA2LSB)
+    {
+        fprintf(stderr, "%s: not a little endian ELF file\n", name);
+        return -1;
+    }
+
+#define FIND_SECTION(Ehdr, Shdr)                                                \
+    do                                                                          \
+    {                                                                           \
+        Ehdr *eh = (Ehdr *)elf;                                                 \
+        Shdr *sh = (Shdr *)(elf + eh->e_shoff);                                 \
+        const char *names = (const char *)elf + sh[eh->e_shstrndx].sh_offset;   \
+                                                                                \
+        for (index = 0; index < eh->e_shnum; index++)                           \
+        {                                                                       \
+            if (!strcmp(names + sh[index].sh_name, SECTION_NAME))               \
+            {                                                                   \
+                offset = sh[index].sh_offset;                                   \
+                length = sh[index].sh_size;                                     \
+                break;                                                          \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+
+    if (elf[EI_CLASS] == ELFCLASS32)
+        FIND_SECTION(Elf32_Ehdr, Elf32_Shdr);
+    else
+        FIND_SECTION(Elf64_Ehdr, Elf64_Shdr);
+
+    if (length == 0 || offset + length > size)
+    {
+        fprintf(stderr, "%s: no %s section\n", name, SECTION_NAME);
+        return -1;
+    }
+
+    /* a terminator after the last string */
+    tokens = malloc(length + 1);
+    memcpy(tokens, elf + offset, length);
+    tokens[length] = '\0';
+    tokens_size = length;
+    free(elf);
+
+    return 0;
+}
+
+/* the argument types, as RT_KTOKEN_TYPES on target */
+#define TYPE_INT            0
+#define TYPE_INT64          1
+#define TYPE_FLOAT          2
+#define TYPE_DOUBLE         3
+#define TYPE_STRING         4
+#define TYPE_MISSING        -1              /* left out of a record cut short */
+#define ARGS_MAX            9
+
+struct argument
+{
+    int type;
+    int64_t i;
+    double d;
+    char s[256];
+};
+
+/* the arguments of the record being formatted */
+static struct argument args[ARGS_MAX];
+static int args_count, args_next;
+
+static const unsigned char *get_varint(const unsigned char *ptr, const unsigned char *end,
+                                       uint64_t *value)
+{
+    int shift = 0;
+
+    *value = 0;
+    while (ptr < end && shift < 64)
+    {
+        *value |= (uint64_t)(*ptr & 0x7f) << shift;
+        if (!(*ptr++ & 0x80))
+            return ptr;
+        shift += 7;
+    }
+
+    return NULL;
+}
+
+static uint64_t get_le(const unsigned char *ptr, int size)
+{
+    uint64_t value = 0;
+    int i;
+
+    for (i = 0; i < size; i++)
+        value |= (uint64_t)ptr[i] << (i * 8);
+
+    return value;
+}
+
+/*
+ * decode the arguments by their types. The encoder leaves out the arguments
+ * which do not fit in a record, so the decoding stops at the first one cut
+ * short, and the rest are missing. Return -1 if the types are bad.
+ */
+static int decode_args(uint32_t types, const unsigned char *ptr, const unsigned char *end)
+{
+    struct argument *arg;
+    uint64_t value;
+    union
+    {
+        double d;
+        uint64_t u;
+    } bits;
+    union
+    {
+        float f;
+        uint32_t u;
+    } fbits;
+
+    args_count = types & 0x0f;
+    args_next = 0;
+    if (args_count > ARGS_MAX)
+        return -1;
+
+    for (arg = args, types >>= 4; arg < args + args_count; arg++, types >>= 3)
+    {
+        arg->type = types & 0x07;
+        if (arg->type > TYPE_STRING)
+            return -1;
+    }
+
+    for (arg = args; arg < args + args_count; arg++)
+    {
+        switch (arg->type)
+        {
+        case TYPE_INT:
+        case TYPE_INT64:
+            ptr = get_varint(ptr, end, &value);
+            arg->i = (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+            break;
+
+        case TYPE_FLOAT:
+            if (end - ptr < 4)
+            {
+                ptr = NULL;
+                break;
+            }
+            fbits.u = (uint32_t)get_le(ptr, 4);
+            arg->d = fbits.f;
+            ptr += 4;
+            break;
+
+        case TYPE_DOUBLE:
+            if (end - ptr < 8)
+            {
+                ptr = NULL;
+                break;
+            }
+            bits.u = get_le(ptr, 8);
+            arg->d = bits.d;
+            ptr += 8;
+            break;
+
+        case TYPE_STRING:
+            ptr = get_varint(ptr, end, &value);
+            if (ptr == NULL || value >= sizeof(arg->s) || value > (uint64_t)(end - ptr))
+            {
+                ptr = NULL;
+                break;
+            }
+            memcpy(arg->s, ptr, value);
+            arg->s[value] = '\0';
+            ptr += value;
+            break;
+        }
+
+        if (ptr == NULL)
+            break;
+    }
+
+    /* the one cut short and the rest, a '*' width of them is 0 */
+    for (; arg < args + args_count; arg++)
+    {
+        arg->type = TYPE_MISSING;
+        arg->i = 0;
+    }
+
+    return 0;
+}
+
+/* take the next argument, one beyond the types is missing */
+static struct argument *next_arg(void)
+{
+    static struct argument none = {TYPE_MISSING};
+
+    if (args_next < args_count)
+        return &args[args_next++];
+
+    return &none;
+}
+
+static double arg_double(struct argument *arg)
+{
+    return (arg->type == TYPE_FLOAT || arg->type == TYPE_DOUBLE) ? arg->d : (double)arg->i;
+}
+
+/*
+ * the shortest digits which convert back to the value, as on target. A value
+ * exactly representable by float only has to convert back to the float.
+ */
+static int print_shortest(char *out, size_t size, char *spec, char conv, double value)
+{
+    char buf[64];
+    int digits, exp, single = ((double)(float)value == value);
+
+    for (digits = 1; digits < 17; digits++)
+    {
+        snprintf(buf, sizeof(buf), "%.*e", digits - 1, value);
+        if (single ? strtof(buf, NULL) == (float)value : strtod(buf, NULL) == value)
+            break;
+    }
+    exp = atoi(strchr(buf, 'e') + 1);
+
+    if (conv == 'g' || conv == 'G')
+        conv = (exp < -4 || exp >= 17) ? conv - 'g' + 'e' : conv - 'g' + 'f';
+    if (conv == 'e' || conv == 'E')
+        sprintf(spec + strlen(spec), ".%d%c", digits - 1, conv);
+    else
+        sprintf(spec + strlen(spec), ".%df", (digits - 1 - exp > 0) ? digits - 1 - exp : 0);
+
+    return snprintf(out, size, spec, value);
+}
+
+/* format the decoded arguments by the format string */
+static size_t format_record(char *out, size_t size, const char *fmt)
+{
+    char spec[32], *s, conv;
+    size_t len = 0;
+    int longlong, precision, n;
+    struct argument *arg;
+
+    while (*fmt && len < size - 1)
+    {
+        if (*fmt != '%')
+        {
+            out[len++] = *fmt++;
+            continue;
+        }
+
+        /* copy the flags, width and precision, then skip the length */
+        s = spec;
+        *s++ = *fmt++;
+        while (*fmt && strchr("-+ #0", *fmt) && s < spec + 8)
+            *s++ = *fmt++;
+        if (*fmt == '*')
+        {
+            fmt++;
+            s += sprintf(s, "%d", (int)next_arg()->i);
+        }
+        while (*fmt >= '0' && *fmt <= '9' && s < spec + 16)
+            *s++ = *fmt++;
+        precision = 0;
+        if (*fmt == '.')
+        {
+            precision = 1;
+            *s++ = *fmt++;
+            if (*fmt == '*')
+            {
+                fmt++;
+                s += sprintf(s, "%d", (int)next_arg()->i);
+            }
+            while (*fmt >= '0' && *fmt <= '9' && s < spec + 24)
+                *s++ = *fmt++;
+        }
+        longlong = 0;
+        while (*fmt == 'l' || *fmt == 'h' || *fmt == 'z')
+        {
+            if (*fmt == 'l' && fmt[1] == 'l')
+                longlong = 1;
+            fmt++;
+        }
+        *s = '\0';
+
+        conv = *fmt;
+        if (conv == '\0')
+            break;
+        fmt++;
+
+        arg = NULL;
+        if (strchr("diuoxXpcseEfFgG", conv))
+        {
+            arg = next_arg();
+            if (arg->type == TYPE_MISSING)
+                conv = '?';
+        }
+
+        switch (conv)
+        {
+        case 'd':
+        case 'i':
+            strcat(spec, "lld");
+            n = snprintf(out + len, size - len, spec,
+                         longlong ? (long long)arg->i : (long long)(int32_t)arg->i);
+            break;
+
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'p':
+            sprintf(s, "ll%c", conv == 'p' ? 'x' : conv);
+            n = snprintf(out + len, size - len, spec,
+                         longlong ? (unsigned long long)arg->i :
+                         (unsigned long long)(uint32_t)arg->i);
+            break;
+
+        case 'c':
+            strcat(spec, "c");
+            n = snprintf(out + len, size - len, spec, (int)arg->i);
+            break;
+
+        case 's':
+            strcat(spec, "s");
+            n = snprintf(out + len, size - len, spec, arg->s);
+            break;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+            if (precision)
+            {
+                sprintf(s, "%c", conv);
+                n = snprintf(out + len, size - len, spec, arg_double(arg));
+            }
+            else
+                n = print_shortest(out + len, size - len, spec, conv, arg_double(arg));
+            break;
+
+        case '%':
+            n = snprintf(out + len, size - len, "%%");
+            break;
+
+        case '?':
+            /* an argument left out by the encoder */
+            n = snprintf(out + len, size - len, "?");
+            break;
+
+        default:
+            n = snprintf(out + len, size - len, "%s%c", spec, conv);
+            break;
+        }
+
+        if (n > 0)
+            len += n;
+    }
+
+    if (len > size - 1)
+        len = size - 1;
+    out[len] = '\0';
+
+    return len;
+}
+
+static int base64_value(int ch)
+{
+    if (ch >= 'A' && ch <= 'Z')
+        return ch - 'A';
+    if (ch >= 'a' && ch <= 'z')
+        return ch - 'a' + 26;
+    if (ch >= '0' && ch <= '9')
+        return ch - '0' + 52;
+    if (ch == '+')
+        return 62;
+    if (ch == '/')
+        return 63;
+
+    return -1;
+}
+
+/* decode a base64 record and print its text, return 0 on success */
+static int decode_record(const char *b64, size_t b64_len)
+{
+    unsigned char bin[RECORD_MAX];
+    const unsigned char *ptr;
+    char text[RECORD_MAX * 4];
+    size_t i, len = 0;
+    uint32_t bits = 0;
+    int nbits = 0;
+    uint64_t token;
+
+    for (i = 0; i < b64_len && len < sizeof(bin); i++)
+    {
+        bits = (bits << 6) | base64_value(b64[i]);
+        nbits += 6;
+        if (nbits >= 8)
+        {
+            nbits -= 8;
+            bin[len++] = (unsigned char)(bits >> nbits);
+        }
+    }
+
+    /* the entry of token is the argument types and the format */
+    ptr = get_varint(bin, bin + len, &token);
+    if (ptr == NULL || token * 4 + 4 > tokens_size)
+        return -1;
+    if (decode_args((uint32_t)get_le((unsigned char *)tokens + token * 4, 4), ptr, bin + len) < 0)
+        return -1;
+
+    format_record(text, sizeof(text), tokens + token * 4 + 4);
+    fputs(text, stdout);
+    record_count++;
+    console_bytes += b64_len + 2;
+    text_bytes += strlen(text);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *fp = stdin;
+    char line[RECORD_MAX * 2], *dollar, *p;
+    int summary = 0;
+
+    if (argc > 1 && !strcmp(argv[1], "-s"))
+    {
+        summary = 1;
+        argc--;
+        argv++;
+    }
+
+    if (argc < 2 || argc > 3)
+    {
+        fprintf(stderr, "usage: ktoken [-s] firmware.elf [log]\n");
+        return 1;
+    }
+
+    if (load_tokens(argv[1]) < 0)
+        return 1;
+
+    if (argc == 3)
+    {
+        fp = fopen(argv[2], "r");
+        if (fp == NULL)
+        {
+            perror(argv[2]);
+            return 1;
+        }
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        /* a record is a '$' and base64 up to the end of line, after the
+         * timestamp of asynchronous rt_kprintf if any */
+        dollar = strchr(line, '$');
+        if (dollar != NULL)
+        {
+            for (p = dollar + 1; base64_value(*p) >= 0; p++)
+                ;
+            if ((*p == '\n' || *p == '\r' || *p == '\0') && p > dollar + 1)
+            {
+                fwrite(line, 1, dollar - line, stdout);
+                if (decode_record(dollar + 1, p - dollar - 1) == 0)
+                    continue;
+
+                record_bad++;
+                fputs("<bad record> ", stdout);
+                fputs(dollar, stdout);
+                continue;
+            }
+        }
+
+        fputs(line, stdout);
+    }
+
+    if (summary)
+    {
+        fprintf(stderr, "%lu records, %lu bad, %lu bytes on console for %lu bytes of text",
+                record_count, record_bad, console_bytes, text_bytes);
+        if (text_bytes)
+            fprintf(stderr, " (%.1f%%)", 100.0 * console_bytes / text_bytes);
+        fprintf(stderr, "\n");
+    }
+
+    return 0;
+}
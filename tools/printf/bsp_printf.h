@@ -0,0 +1,2 @@
+/* the console output of BSP, which the host test does not use */
+int printfNexys(const char *fmt, ...);
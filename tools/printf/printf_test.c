@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * Host test of the floating point format of rt_vsnprintf.
+ *
+ * The output with a precision is compared with the host C library, which
+ * rounds the exact binary value, an exact tie to even:
+ *
+ *   - the values near powers of ten, 10^k +- 2^-j and 10^k +- 5 * 10^m,
+ *     whose digits are 4999.. or 5000.. after the rounding position;
+ *   - random exact ties m * 2^-j, and random doubles;
+ *
+ * each of them in %.*e, %.*f and %.*g with the precisions up to 17
+ * significant digits, rt_vsnprintf prints zeros after them.
+ * Without precision, rt_vsnprintf prints the shortest digits, which are
+ * checked to convert back to the value. %#g must keep the trailing zeros
+ * and the point as the C library does for the values of 6 digits or less.
+ *
+ * usage: printf_test [random_count]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include <rtthread.h>
+
+/* the kernel services kservice.c needs */
+rt_thread_t rt_thread_self(void)
+{
+    return RT_NULL;
+}
+
+rt_uint8_t rt_interrupt_get_nest(void)
+{
+    return 0;
+}
+
+/* the significant digits rt_vsnprintf prints, zeros follow them */
+#define DIGITS_MAX      17
+#define REPORT_MAX      20
+
+static unsigned long checked, failed;
+
+static void check(const char *fmt, int precision, double value)
+{
+    char rt[512], libc[512];
+
+    if (precision < 0)
+    {
+        rt_snprintf(rt, sizeof(rt), fmt, value);
+        snprintf(libc, sizeof(libc), fmt, value);
+    }
+    else
+    {
+        rt_snprintf(rt, sizeof(rt), fmt, precision, value);
+        snprintf(libc, sizeof(libc), fmt, precision, value);
+    }
+
+    checked ++;
+    if (strcmp(rt, libc) != 0)
+    {
+        if (failed ++ < REPORT_MAX)
+            printf("%-6s %2d %-24.17g rt [%s] libc [%s]\n", fmt, precision, value, rt, libc);
+    }
+}
+
+static void check_precisions(double value)
+{
+    int precision, exp;
+
+    exp = value != 0 ? (int)floor(log10(value)) : 0;
+    for (precision = 0; precision <= DIGITS_MAX; precision++)
+    {
+        if (precision + 1 <= DIGITS_MAX)
+        {
+            check("%.*e", precision, value);
+            check("%+.*e", precision, -value);
+        }
+        if (exp + 1 + precision <= DIGITS_MAX)
+            check("%.*f", precision, value);
+        check("%.*g", precision, value);
+    }
+}
+
+/* the shortest digits must convert back to the value */
+static void check_shortest(double value)
+{
+    static const char *fmts[] = { "%e", "%f", "%g" };
+    char rt[512];
+    int index;
+
+    for (index = 0; index < 3; index++)
+    {
+        rt_snprintf(rt, sizeof(rt), fmts[index], value);
+
+        checked ++;
+        if (strtod(rt, NULL) != value && failed ++ < REPORT_MAX)
+            printf("%-6s    %-24.17g rt [%s] does not convert back\n", fmts[index], value, rt);
+    }
+}
+
+static double random_double(void)
+{
+    uint64_t bits;
+    double value;
+
+    do
+    {
+        bits = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+        memcpy(&value, &bits, sizeof(value));
+    } while (!isfinite(value));
+
+    return fabs(value);
+}
+
+int main(int argc, char *argv[])
+{
+    static const double sharp[] = { 0, 1, 1.5, 0.1, 100, 123456, 1e-5, 1e-4, 1e10, 2.5e-7 };
+    long count = argc > 1 ? strtol(argv[1], NULL, 0) : 20000;
+    double power, half, value;
+    uint64_t m;
+    long index;
+    int k, j;
+
+    /* 10^k +- 2^-j, an exact tie at the last fraction digit */
+    for (k = 0, power = 1; k <= 22; k++, power *= 10)
+    {
+        for (j = 1, half = 0.5; j <= 20; j++, half /= 2)
+        {
+            if (power + half - power == half)
+                check_precisions(power + half);
+            if (power - half - power == -half)
+                check_precisions(power - half);
+        }
+    }
+
+    /* 10^k +- 5 * 10^j, an exact tie in the integer digits */
+    for (k = 1, power = 10; k <= 22; k++, power *= 10)
+    {
+        for (j = 0, half = 5; j < k; j++, half *= 10)
+        {
+            check_precisions(power + half);
+            check_precisions(power - half);
+        }
+    }
+
+    /* random ties: an odd mantissa below 2^53 scaled by 2^-j */
+    srand(1);
+    for (index = 0; index < count; index++)
+    {
+        m = (((uint64_t)rand() << 31) ^ (uint64_t)rand()) & ((1ULL << 53) - 1);
+        value = ldexp((double)(m | 1), -(rand() % 60));
+        check_precisions(value);
+        check_precisions(random_double());
+        check_shortest(random_double());
+    }
+
+    /* '#' keeps the trailing zeros and the point without precision */
+    for (index = 0; index < sizeof(sharp) / sizeof(sharp[0]); index++)
+    {
+        check("%#g", -1, sharp[index]);
+        check("%#G", -1, -sharp[index]);
+    }
+
+    printf("%lu checked, %lu failed\n", checked, failed);
+
+    return failed != 0;
+}
@@ -0,0 +1,16 @@
+/* RT-Thread config file for the host test of rt_vsnprintf */
+#ifndef __RTTHREAD_CFG_H__
+#define __RTTHREAD_CFG_H__
+
+#define RT_NAME_MAX         8
+#define RT_ALIGN_SIZE       8
+#define RT_THREAD_PRIORITY_MAX  32
+#define RT_TICK_PER_SECOND  1000
+
+/* use the host C library va_list */
+#define RT_USING_NEWLIB
+
+#define RT_PRINTF_LONGLONG
+#define RT_PRINTF_FLOAT
+
+#endif
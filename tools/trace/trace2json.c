@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     tangmenglin  the first version
+ */
+
+/*
+ * Event trace converter.
+ *
+ * Reads the console output of the "trace snapshot" shell command and writes
+ * the events in the Chrome trace event format (JSON), which is opened by
+ * https://ui.perfetto.dev or chrome://tracing:
+ *
+ *   - a track for each thread, with a slice while the thread runs;
+ *   - an "interrupt" track, with a slice for each interrupt;
+ *   - a "timer" track, with a slice for each timeout function;
+ *   - the IPC operations as instant events on the track of current thread.
+ *
+ * The other lines of console log are ignored. If the log holds several
+ * snapshots, the last one is converted.
+ *
+ * The cycle count of records is 32 bits, it is extended on the assumption
+ * that two records are less than a wraparound apart. The frequency of
+ * cycle counter is taken from the snapshot, or given by -f.
+ *
+ * usage: trace2json [-f cycles_per_second] [log] > trace.json
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* the events and object classes, as defined in rtdef.h */
+#define TRACE_SWITCH        0
+#define TRACE_TRYTAKE       1
+#define TRACE_TAKE          2
+#define TRACE_PUT           3
+#define TRACE_IRQ_ENTER     4
+#define TRACE_IRQ_LEAVE     5
+#define TRACE_TIMER_ENTER   6
+#define TRACE_TIMER_EXIT    7
+#define TRACE_EVENT_MASK    7
+
+#define CLASS_THREAD        1
+
+#define NAME_MAX_LEN        32
+#define LINE_MAX_LEN        256
+
+/* the fixed tracks, the threads are numbered after them */
+#define TID_INTERRUPT       1
+#define TID_TIMER           2
+#define TID_THREAD_BASE     16
+
+struct trace_record
+{
+    uint32_t timestamp;
+    uint32_t object;
+};
+
+struct trace_object
+{
+    uint32_t address;
+    int type;
+    int tid;
+    char name[NAME_MAX_LEN];
+};
+
+static struct trace_record *records;
+static size_t record_count, record_size;
+
+static struct trace_object *objects;
+static size_t object_count, object_size;
+
+static unsigned long frequency;
+static int thread_tracks;
+
+static void trace_reset(void)
+{
+    record_count = 0;
+    object_count = 0;
+    thread_tracks = 0;
+}
+
+static void record_add(uint32_t timestamp, uint32_t object)
+{
+    if (record_count == record_size)
+    {
+        record_size = record_size ? record_size * 2 : 1024;
+        records = realloc(records, record_size * sizeof(records[0]));
+        if (records == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+
+    records[record_count].timestamp = timestamp;
+    records[record_count].object = object;
+    record_count ++;
+}
+
+static struct trace_object *object_find(uint32_t address)
+{
+    size_t index;
+
+    for (index = 0; index < object_count; index++)
+    {
+        if (objects[index].address == address)
+            return &objects[index];
+    }
+
+    return NULL;
+}
+
+static struct trace_object *object_add(uint32_t address, int type, const char *name)
+{
+    struct trace_object *object;
+
+    object = object_find(address);
+    if (object == NULL)
+    {
+        if (object_count == object_size)
+        {
+            object_size = object_size ? object_size * 2 : 64;
+            objects = realloc(objects, object_size * sizeof(objects[0]));
+            if (objects == NULL)
+            {
+                fprintf(stderr, "out of memory\n");
+                exit(1);
+            }
+        }
+
+        object = &objects[object_count ++];
+        object->address = address;
+        object->tid = 0;
+    }
+
+    object->type = type;
+    snprintf(object->name, sizeof(object->name), "%s", name);
+
+    return object;
+}
+
+/* the object of a record, the anonymous objects are named by address */
+static struct trace_object *object_get(uint32_t address, int type)
+{
+    struct trace_object *object;
+    char name[NAME_MAX_LEN];
+
+    object = object_find(address);
+    if (object == NULL)
+    {
+        snprintf(name, sizeof(name), "%08x", address);
+        object = object_add(address, type, name);
+    }
+
+    return object;
+}
+
+static int thread_tid(uint32_t address)
+{
+    struct trace_object *object;
+
+    object = object_get(address, CLASS_THREAD);
+    if (object->tid == 0)
+    {
+        object->tid = TID_THREAD_BASE + thread_tracks ++;
+
+        printf(",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\","
+               "\"args\":{\"name\":\"%s\"}}", object->tid, object->name);
+        printf(",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_sort_index\","
+               "\"args\":{\"sort_index\":%d}}", object->tid, object->tid);
+    }
+
+    return object->tid;
+}
+
+static int trace_load(FILE *fp)
+{
+    char line[LINE_MAX_LEN];
+    char name[NAME_MAX_LEN];
+    unsigned long w[3];
+    int type;
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (strncmp(line, "# trace:", 8) == 0)
+        {
+            /* a new snapshot */
+            trace_reset();
+            if (sscanf(line + 8, "%lu records, %lu lost, %lu", &w[0], &w[1], &w[2]) == 3 &&
+                frequency == 0)
+            {
+                frequency = w[2];
+            }
+        }
+        else if (line[0] == 'O' && line[1] == ' ')
+        {
+            name[0] = '\0';
+            if (sscanf(line + 2, "%lx %d %31s", &w[0], &type, name) >= 2)
+                object_add((uint32_t)w[0], type, name);
+        }
+        else if (sscanf(line, "%8lx %8lx", &w[0], &w[1]) == 2 &&
+                 strlen(line) >= 17 && line[8] == ' ')
+        {
+            record_add((uint32_t)w[0], (uint32_t)w[1]);
+        }
+        /* the other lines of console log are ignored */
+    }
+
+    return record_count != 0 ? 0 : -1;
+}
+
+static void trace_convert(void)
+{
+    uint64_t cycles = 0;
+    uint32_t last = 0;
+    struct trace_object *object;
+    double ts;
+    size_t index;
+    int current = 0, irq_depth = 0, timer_depth = 0;
+    int event, tid;
+
+    printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    printf("{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"rt-thread\"}}");
+    printf(",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\","
+           "\"args\":{\"name\":\"interrupt\"}}", TID_INTERRUPT);
+    printf(",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\","
+           "\"args\":{\"name\":\"timer\"}}", TID_TIMER);
+
+    for (index = 0; index < record_count; index++)
+    {
+        event = records[index].timestamp & TRACE_EVENT_MASK;
+
+        /* extend the cycle count to 64 bits */
+        if (index != 0)
+            cycles += (uint32_t)((records[index].timestamp & ~TRACE_EVENT_MASK) - last);
+        last = records[index].timestamp & ~TRACE_EVENT_MASK;
+        ts = (double)cycles * 1000000.0 / frequency;
+
+        switch (event)
+        {
+        case TRACE_SWITCH:
+            tid = thread_tid(records[index].object);
+            if (current != 0)
+                printf(",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", current, ts);
+            printf(",\n{\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":\"running\"}", tid, ts);
+            current = tid;
+            break;
+
+        case TRACE_TRYTAKE:
+        case TRACE_TAKE:
+        case TRACE_PUT:
+            object = object_get(records[index].object, 0);
+            printf(",\n{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":\"%s %s\"}",
+                   current != 0 ? current : TID_INTERRUPT, ts,
+                   event == TRACE_TRYTAKE ? "trytake" : event == TRACE_TAKE ? "take" : "put",
+                   object->name);
+            break;
+
+        case TRACE_IRQ_ENTER:
+            printf(",\n{\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":\"irq\","
+                   "\"args\":{\"nest\":%u}}", TID_INTERRUPT, ts, records[index].object);
+            irq_depth ++;
+            break;
+
+        case TRACE_IRQ_LEAVE:
+            /* the snapshot may begin inside an interrupt */
+            if (irq_depth == 0)
+                break;
+            printf(",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", TID_INTERRUPT, ts);
+            irq_depth --;
+            break;
+
+        case TRACE_TIMER_ENTER:
+            object = object_get(records[index].object, 0);
+            printf(",\n{\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":\"%s\"}",
+                   TID_TIMER, ts, object->name);
+            timer_depth ++;
+            break;
+
+        case TRACE_TIMER_EXIT:
+            if (timer_depth == 0)
+                break;
+            printf(",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", TID_TIMER, ts);
+            timer_depth --;
+            break;
+        }
+    }
+
+    printf("\n]}\n");
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: trace2json [-f cycles_per_second] [log] > trace.json\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *fp = stdin;
+    int index;
+
+    for (index = 1; index < argc && argv[index][0] == '-'; index++)
+    {
+        if (strcmp(argv[index], "-f") == 0 && index + 1 < argc)
+            frequency = strtoul(argv[++ index], NULL, 0);
+        else
+            usage();
+    }
+
+    if (index < argc)
+    {
+        fp = fopen(argv[index], "r");
+        if (fp == NULL)
+        {
+            perror(argv[index]);
+            return 1;
+        }
+    }
+
+    if (trace_load(fp) != 0)
+    {
+        fprintf(stderr, "no trace records found\n");
+        return 1;
+    }
+    if (fp != stdin)
+        fclose(fp);
+
+    if (frequency == 0)
+    {
+        fprintf(stderr, "unknown frequency of cycle counter, use -f\n");
+        return 1;
+    }
+
+    trace_convert();
+
+    return 0;
+}